@@ -0,0 +1,425 @@
+#include "default.h"
+#include "Dijkstra.h"
+#include "CSR_Graph.h"
+#include "Query_Generator.h"
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <map>
+
+using namespace std;
+
+/**
+ * @brief 基准测试配置，均可由命令行覆盖
+ */
+struct BenchConfig{
+    string grPath; // DIMACS .gr路径，为空时用合成网格
+    int grid = 300; // 合成网格边长
+    int queries = 1000;
+    unsigned seed = 1;
+    int warmup = 50;
+    int reps = 3;
+    string csvPath;
+    string jsonPath;
+    string heaps; // 逗号分隔的堆名，为空表示全部
+    string queryFile; // querygen生成的查询集，为空时按种子均匀随机生成
+};
+
+/**
+ * @brief 一个(图, 堆)组合的测试结果
+ */
+struct BenchResult{
+    string graph;
+    string heap;
+    int stratum; // 查询集的层，均匀随机为-1
+    int queries;
+    int reps;
+    double p50; // 微秒
+    double p90;
+    double p99;
+    double mean;
+    double throughput; // 每秒查询数
+    double settled; // 每次查询平均确定的顶点数
+    double scanned; // 每次查询平均扫描的边数
+    SearchStats stats; // 第一遍查询的计数之和，需make STATS=1
+    bool consistent; // 与第一个堆的距离是否一致
+};
+
+/**
+ * @brief 合成带随机权值的双向网格，边权模拟路网的距离量级
+ */
+static void buildGrid(int width, unsigned seed, Graph& graph)
+{
+    mt19937 rng(seed);
+    auto id = [&](int x, int y){return y * width + x + 1;};
+    for(int y = 0; y < width; y++)
+        for(int x = 0; x < width; x++)
+        {
+            if(x + 1 < width)
+            {
+                int w = rng() % 3000 + 1;
+                graph.addEdge(id(x, y), id(x + 1, y), w);
+                graph.addEdge(id(x + 1, y), id(x, y), w);
+            }
+            if(y + 1 < width)
+            {
+                int w = rng() % 3000 + 1;
+                graph.addEdge(id(x, y), id(x, y + 1), w);
+                graph.addEdge(id(x, y + 1), id(x, y), w);
+            }
+        }
+}
+
+/**
+ * @brief 有序样本的最近秩百分位数
+ */
+static double percentile(const vector<double>& sorted, double p)
+{
+    if(sorted.empty())
+        return 0;
+    size_t rank = (size_t)ceil(p * sorted.size());
+    return sorted[min(sorted.size(), max<size_t>(rank, 1)) - 1];
+}
+
+/**
+ * @class CountingGraph
+ * @brief 包装一个图，在搜索调用edges()时统计确定的顶点数和扫描的边数
+ * 
+ * 搜索只对确定的顶点取出边，终点确定后立即退出、不取它的出边，所以终点要另外加1。
+ * 计数来自搜索本身，开销与确定的顶点数成正比，与V无关。
+ */
+template<class GraphT>
+class CountingGraph
+{
+private:
+    const GraphT& graph;
+    long long* settled;
+    long long* scanned;
+
+public:
+    CountingGraph(const GraphT& graph, long long& settled, long long& scanned)
+        :graph(graph), settled(&settled), scanned(&scanned){};
+    int getBound() const {return graph.getBound();};
+    int index(const int& name) const {return graph.index(name);};
+    int name(const int& u) const {return graph.name(u);};
+    EdgeRange edges(const int& u) const
+    {
+        EdgeRange range = graph.edges(u);
+        (*settled)++;
+        *scanned += range.size();
+        return range;
+    };
+};
+
+/**
+ * @brief 不计时地把查询再跑一遍，累加确定的顶点数和扫描的边数
+ */
+template<class Queue, class GraphT>
+static void countWork(const GraphT& graph, Queue& queue, DijkstraWorkspace& workspace, const pair<int, int>& query,
+                      long long& settled, long long& scanned)
+{
+    try{
+        dijkstra(CountingGraph<GraphT>(graph, settled, scanned), query.first, query.second, queue, workspace);
+        settled++; // 终点
+    }catch(const char*){
+    }
+}
+
+#ifdef SEARCH_STATS
+/**
+ * @brief 把一次查询的计数累加到总数，maxHeapSize取最大值
+ */
+static void accumulate(SearchStats& total, const SearchStats& query)
+{
+    total.inserts += query.inserts;
+    total.decreaseKeys += query.decreaseKeys;
+    total.removeMins += query.removeMins;
+    total.links += query.links;
+    total.cuts += query.cuts;
+    total.settled += query.settled;
+    total.relaxed += query.relaxed;
+    total.maxHeapSize = max(total.maxHeapSize, query.maxHeapSize);
+}
+#endif
+
+/**
+ * @brief 在一种图上用一种堆跑完整个查询集
+ * 
+ * 先跑warmup次查询预热，再把查询集重复reps遍，逐次记录延迟。
+ * 距离写入distances，供不同堆之间核对。
+ */
+template<class Queue, class GraphT>
+static BenchResult runCase(const string& graphName, const string& heapName, const GraphT& graph, Queue& queue,
+                           const vector<pair<int, int>>& queries, const BenchConfig& config, vector<int>& distances)
+{
+    DijkstraWorkspace workspace;
+    auto run = [&](const pair<int, int>& q){
+        try{
+            return dijkstra(graph, q.first, q.second, queue, workspace);
+        }catch(const char*){
+            return INF;
+        }
+    };
+    for(int i = 0; i < config.warmup && !queries.empty(); i++)
+        run(queries[i % queries.size()]);
+
+    vector<double> samples;
+    samples.reserve(queries.size() * config.reps);
+    distances.assign(queries.size(), INF);
+    long long settled = 0, scanned = 0;
+    SearchStats stats;
+    double total = 0;
+    for(int rep = 0; rep < config.reps; rep++)
+    {
+        for(size_t i = 0; i < queries.size(); i++)
+        {
+            auto t1 = chrono::steady_clock::now();
+            int d = run(queries[i]);
+            auto t2 = chrono::steady_clock::now();
+            double us = chrono::duration<double, micro>(t2 - t1).count();
+            samples.push_back(us);
+            total += us;
+            if(rep == 0)
+            {
+                distances[i] = d;
+#ifdef SEARCH_STATS
+                accumulate(stats, lastSearchStats());
+#endif
+                countWork(graph, queue, workspace, queries[i], settled, scanned);
+            }
+        }
+    }
+    sort(samples.begin(), samples.end());
+    BenchResult result;
+    result.graph = graphName;
+    result.heap = heapName;
+    result.stratum = -1;
+    result.queries = queries.size();
+    result.reps = config.reps;
+    result.p50 = percentile(samples, 0.50);
+    result.p90 = percentile(samples, 0.90);
+    result.p99 = percentile(samples, 0.99);
+    result.mean = samples.empty() ? 0 : total / samples.size();
+    result.throughput = total > 0 ? samples.size() / (total / 1e6) : 0;
+    result.settled = queries.empty() ? 0 : (double)settled / queries.size();
+    result.scanned = queries.empty() ? 0 : (double)scanned / queries.size();
+    result.stats = stats;
+    result.consistent = true;
+    return result;
+}
+
+/**
+ * @brief 参与测试的堆。新增一种堆只需在这里加一行
+ */
+template<class GraphT>
+static vector<pair<string, function<BenchResult(const string&, const GraphT&, const vector<pair<int, int>>&,
+                                                const BenchConfig&, vector<int>&)>>> heapCases()
+{
+    using Runner = function<BenchResult(const string&, const GraphT&, const vector<pair<int, int>>&, const BenchConfig&, vector<int>&)>;
+    vector<pair<string, Runner>> cases;
+    auto add = [&](const string& name, auto make){
+        cases.push_back(make_pair(name, Runner([name, make](const string& graphName, const GraphT& graph,
+                const vector<pair<int, int>>& queries, const BenchConfig& config, vector<int>& distances){
+            auto queue = make(graph);
+            return runCase(graphName, name, graph, *queue, queries, config, distances);
+        })));
+    };
+    add("fib", [](const GraphT& g){return make_unique<FibHeap>(g.getBound());});
+    add("index_fib", [](const GraphT& g){return make_unique<Index_Fib_Heap>(g.getBound());});
+    add("binomial", [](const GraphT& g){return make_unique<Binomial_Queue>(g.getBound());});
+    add("binary", [](const GraphT& g){return make_unique<Binary_Heap>(2, g.getBound());});
+    add("4-ary", [](const GraphT& g){return make_unique<Binary_Heap>(4, g.getBound());});
+    add("8-ary", [](const GraphT& g){return make_unique<Binary_Heap>(8, g.getBound());});
+    add("pairing", [](const GraphT& g){return make_unique<Pairing_Heap>(g.getBound());});
+    add("rank_pairing", [](const GraphT& g){return make_unique<Rank_Pairing_Heap>(g.getBound());});
+    add("radix", [](const GraphT& g){return make_unique<Radix_Heap>(g.getBound());});
+    add("dial", [](const GraphT& g){return make_unique<Dial_Queue>(g.getMaxWeight(), g.getBound());});
+    add("lazy", [](const GraphT& g){return make_unique<Lazy_Queue>(g.getBound());});
+    return cases;
+}
+
+/**
+ * @brief 判断堆是否在--heaps列表中
+ */
+static bool selected(const BenchConfig& config, const string& heap)
+{
+    if(config.heaps.empty())
+        return true;
+    stringstream list(config.heaps);
+    string item;
+    while(getline(list, item, ','))
+        if(item == heap)
+            return true;
+    return false;
+}
+
+/**
+ * @brief 在一种图上跑所有选中的堆，并与第一个堆的距离核对
+ */
+template<class GraphT>
+static void runGraph(const string& graphName, const GraphT& graph, int stratum, const vector<pair<int, int>>& queries,
+                     const BenchConfig& config, vector<BenchResult>& results, vector<int>& reference)
+{
+    for(auto& entry : heapCases<GraphT>())
+    {
+        if(!selected(config, entry.first))
+            continue;
+        vector<int> distances;
+        BenchResult result = entry.second(graphName, graph, queries, config, distances);
+        result.stratum = stratum;
+        if(reference.empty())
+            reference = distances;
+        result.consistent = distances == reference;
+        results.push_back(result);
+        cout << left << setw(6) << result.graph << setw(14) << result.heap << right << setw(4) << stratum
+             << fixed << setprecision(1)
+             << " p50 " << setw(10) << result.p50 << "us"
+             << " p90 " << setw(10) << result.p90 << "us"
+             << " p99 " << setw(10) << result.p99 << "us"
+             << " " << setw(9) << result.throughput << " q/s"
+             << " settled " << setw(9) << result.settled
+             << " scanned " << setw(9) << result.scanned
+             << (result.consistent ? "" : "  MISMATCH") << endl;
+#ifdef SEARCH_STATS
+        const SearchStats& st = result.stats;
+        double n = max(1, result.queries);
+        cout << "      per query: insert " << st.inserts / n << " decrease " << st.decreaseKeys / n
+             << " removeMin " << st.removeMins / n << " link " << st.links / n << " cut " << st.cuts / n
+             << " relaxed " << st.relaxed / n << ", max heap " << st.maxHeapSize << endl;
+#endif
+    }
+}
+
+static void writeCsv(const string& path, const vector<BenchResult>& results)
+{
+    ofstream out(path);
+    if(!out.is_open())
+        throw "Unable to open file";
+    out << "graph,heap,stratum,queries,reps,p50_us,p90_us,p99_us,mean_us,throughput_qps,settled_avg,scanned_avg,"
+           "inserts,decrease_keys,remove_mins,links,cuts,stat_settled,relaxed,max_heap,consistent\n";
+    for(const BenchResult& r : results)
+        out << r.graph << ',' << r.heap << ',' << r.stratum << ',' << r.queries << ',' << r.reps << ','
+            << r.p50 << ',' << r.p90 << ',' << r.p99 << ',' << r.mean << ',' << r.throughput << ','
+            << r.settled << ',' << r.scanned << ','
+            << r.stats.inserts << ',' << r.stats.decreaseKeys << ',' << r.stats.removeMins << ','
+            << r.stats.links << ',' << r.stats.cuts << ',' << r.stats.settled << ','
+            << r.stats.relaxed << ',' << r.stats.maxHeapSize << ',' << (r.consistent ? "true" : "false") << '\n';
+}
+
+static void writeJson(const string& path, const BenchConfig& config, const vector<BenchResult>& results)
+{
+    ofstream out(path);
+    if(!out.is_open())
+        throw "Unable to open file";
+#ifdef SEARCH_STATS
+    const char* stats = "true";
+#else
+    const char* stats = "false";
+#endif
+    out << "{\n  \"seed\": " << config.seed << ",\n  \"warmup\": " << config.warmup
+        << ",\n  \"stats\": " << stats << ",\n  \"results\": [\n";
+    for(size_t i = 0; i < results.size(); i++)
+    {
+        const BenchResult& r = results[i];
+        out << "    {\"graph\": \"" << r.graph << "\", \"heap\": \"" << r.heap << "\", \"stratum\": " << r.stratum
+            << ", \"queries\": " << r.queries
+            << ", \"reps\": " << r.reps << ", \"p50_us\": " << r.p50 << ", \"p90_us\": " << r.p90
+            << ", \"p99_us\": " << r.p99 << ", \"mean_us\": " << r.mean << ", \"throughput_qps\": " << r.throughput
+            << ", \"settled_avg\": " << r.settled << ", \"scanned_avg\": " << r.scanned
+            << ", \"inserts\": " << r.stats.inserts << ", \"decrease_keys\": " << r.stats.decreaseKeys
+            << ", \"remove_mins\": " << r.stats.removeMins << ", \"links\": " << r.stats.links
+            << ", \"cuts\": " << r.stats.cuts << ", \"relaxed\": " << r.stats.relaxed
+            << ", \"max_heap\": " << r.stats.maxHeapSize
+            << ", \"consistent\": " << (r.consistent ? "true" : "false") << "}"
+            << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+}
+
+static void usage()
+{
+    cout << "usage: benchmark [--gr file.gr | --grid N] [--queries N | --query-file file] [--seed S] [--warmup N] [--reps N]\n"
+            "                 [--heaps fib,4-ary,...] [--csv out.csv] [--json out.json]" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    BenchConfig config;
+    for(int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if(arg == "--help" || arg == "-h")
+        {
+            usage();
+            return 0;
+        }
+        if(i + 1 >= argc)
+        {
+            usage();
+            return 1;
+        }
+        string value = argv[++i];
+        if(arg == "--gr") config.grPath = value;
+        else if(arg == "--grid") config.grid = stoi(value);
+        else if(arg == "--queries") config.queries = stoi(value);
+        else if(arg == "--seed") config.seed = stoul(value);
+        else if(arg == "--warmup") config.warmup = stoi(value);
+        else if(arg == "--reps") config.reps = stoi(value);
+        else if(arg == "--heaps") config.heaps = value;
+        else if(arg == "--csv") config.csvPath = value;
+        else if(arg == "--json") config.jsonPath = value;
+        else if(arg == "--query-file") config.queryFile = value;
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    try{
+        Graph graph;
+        CSRGraph csr;
+        if(config.grPath.empty())
+        {
+            buildGrid(config.grid, config.seed, graph);
+            csr.buildFromGraph(graph);
+        }
+        else
+        {
+            graph.buildGraphFromgr(config.grPath);
+            csr.buildFromgr(config.grPath);
+        }
+        vector<Query> workload;
+        if(config.queryFile.empty())
+            workload = QueryGenerator(csr, config.seed).random(config.queries);
+        else
+            workload = QueryGenerator::load(config.queryFile);
+        // 分层的查询集按层分别统计，观察各个堆随查询距离的变化
+        map<int, vector<pair<int, int>>> strata;
+        for(const Query& q : workload)
+            strata[q.stratum].push_back(make_pair(q.src, q.dest));
+        cout << "V = " << csr.getV() << ", E = " << csr.getE() << ", queries = " << workload.size()
+             << ", strata = " << strata.size() << ", reps = " << config.reps << ", seed = " << config.seed << endl;
+        vector<BenchResult> results;
+        for(auto& stratum : strata)
+        {
+            vector<int> reference;
+            runGraph("csr", csr, stratum.first, stratum.second, config, results, reference);
+            runGraph("graph", graph, stratum.first, stratum.second, config, results, reference);
+        }
+        // 下标版斐波那契堆在网格和路网上都比指针版慢，保留它只作对照
+        if(selected(config, "index_fib"))
+            cout << "note: index_fib is experimental and has measured slower than fib; kept for comparison only" << endl;
+        if(!config.csvPath.empty())
+            writeCsv(config.csvPath, results);
+        if(!config.jsonPath.empty())
+            writeJson(config.jsonPath, config, results);
+        for(const BenchResult& r : results)
+            if(!r.consistent)
+                return 2;
+    }catch(const char* msg){
+        cout << msg << endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include "default.h"
+#include "CSR_Graph.h"
+#include "Query_Generator.h"
+
+using namespace std;
+
+static void usage()
+{
+    cout << "usage: querygen --gr file.gr [--co file.co] [--mode random|rank|geo] [--count N] [--seed S] --out file\n"
+            "  random: N uniform pairs\n"
+            "  rank:   N sources, one query per Dijkstra rank 2^k\n"
+            "  geo:    N sources, one query per distance band [2^k, 2^(k+1)) m, needs --co" << endl;
+}
+
+int main(int argc, char** argv)
+{
+    string grPath, coPath, mode = "rank", outPath;
+    int count = 100;
+    unsigned seed = 1;
+    for(int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if(arg == "--help" || arg == "-h" || i + 1 >= argc)
+        {
+            usage();
+            return arg == "--help" || arg == "-h" ? 0 : 1;
+        }
+        string value = argv[++i];
+        if(arg == "--gr") grPath = value;
+        else if(arg == "--co") coPath = value;
+        else if(arg == "--mode") mode = value;
+        else if(arg == "--count") count = stoi(value);
+        else if(arg == "--seed") seed = stoul(value);
+        else if(arg == "--out") outPath = value;
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    if(grPath.empty() || outPath.empty())
+    {
+        usage();
+        return 1;
+    }
+    try{
+        CSRGraph csr;
+        csr.buildFromgr(grPath);
+        QueryGenerator generator(csr, seed);
+        if(!coPath.empty())
+            generator.loadCoordinates(coPath);
+        vector<Query> queries;
+        if(mode == "random")
+            queries = generator.random(count);
+        else if(mode == "rank")
+            queries = generator.byRank(count);
+        else if(mode == "geo")
+            queries = generator.byDistance(count);
+        else
+        {
+            usage();
+            return 1;
+        }
+        QueryGenerator::save(outPath, queries, "querygen " + grPath + " mode " + mode + " count " + to_string(count)
+                             + " seed " + to_string(seed));
+        cout << queries.size() << " queries written to " << outPath << endl;
+    }catch(const char* msg){
+        cout << msg << endl;
+        return 1;
+    }
+    return 0;
+}
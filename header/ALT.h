@@ -0,0 +1,155 @@
+#ifndef __ALT_H
+#define __ALT_H
+
+#include "default.h"
+#include "Dijkstra.h"
+#include "CSR_Graph.h"
+
+using namespace std;
+
+/**
+ * @brief 地标选择策略
+ */
+enum LandmarkSelection
+{
+    FARTHEST, // 每次选离已选地标最远的顶点
+    AVOID     // Goldberg-Werneck的avoid策略：选下界最差的最短路树分支的叶子
+};
+
+/**
+ * @brief 距离表的下标含义，须与查询所用的图一致
+ */
+enum LandmarkNumbering
+{
+    NAME_NUMBERING,   // 下标为原顶点名(Graph)
+    COMPACT_NUMBERING // 下标为CSR重新编号后的顶点(CSRGraph)
+};
+
+template<class GraphT>
+constexpr LandmarkNumbering numberingOf()
+{
+    static_assert(is_same_v<GraphT, Graph> || is_same_v<GraphT, CSRGraph>, "Landmarks support Graph and CSRGraph");
+    return is_same_v<GraphT, Graph> ? NAME_NUMBERING : COMPACT_NUMBERING;
+}
+
+/**
+ * @class Landmarks
+ * @brief ALT(A*, Landmarks, Triangle inequality)预处理得到的地标距离表
+ * 
+ * 对每个地标L保存d(L,v)和d(v,L)，按顶点分行存放，同一顶点的k个值相邻。
+ * 由三角不等式，max(d(v,L)-d(t,L), d(L,t)-d(L,v))是d(v,t)的下界。
+ * 距离表按构建所用图的编号存放：Graph的顶点名和CSRGraph的压缩编号不同，
+ * 表只能用于编号方式和上界都相同的图。
+ */
+class Landmarks
+{
+private:
+    int k;
+    int bound; // 顶点编号上界
+    LandmarkNumbering numbering;
+    vector<int> landmarks;
+    vector<int> fromTable; // fromTable[v*k+i] = d(L_i, v)，不可达为MAX
+    vector<int> toTable; // toTable[v*k+i] = d(v, L_i)，不可达为MAX
+
+    template<class GraphT>
+    void buildFrom(const GraphT& graph, int count, LandmarkSelection method, unsigned seed);
+    template<class GraphT>
+    int selectFarthest(const GraphT& graph, const vector<int>& vertices, mt19937& rng) const;
+    template<class GraphT>
+    int selectAvoid(const GraphT& graph, const vector<int>& vertices, mt19937& rng) const;
+    void addLandmark(int landmark, const vector<int>& from, const vector<int>& to);
+
+public:
+    Landmarks():k(0), bound(0), numbering(NAME_NUMBERING){};
+    ~Landmarks(){};
+    const Landmarks& build(const Graph& graph, int count, LandmarkSelection method = AVOID, unsigned seed = 1);
+    const Landmarks& build(const CSRGraph& graph, int count, LandmarkSelection method = AVOID, unsigned seed = 1);
+    int getK() const {return k;};
+    int getBound() const {return bound;};
+    LandmarkNumbering getNumbering() const {return numbering;};
+    /**
+     * @brief 距离表能否用于graph：编号方式和顶点编号上界都须相同
+     */
+    template<class GraphT>
+    bool matches(const GraphT& graph) const {return numbering == numberingOf<GraphT>() && bound == graph.getBound();};
+    const vector<int>& getLandmarks() const {return landmarks;};
+    int potential(int v, int t) const;
+    void save(const string& filePath) const;
+    const Landmarks& load(const string& filePath);
+};
+
+/**
+ * @brief ALT的A*点到点查询，队列键为dist(v)+下界(v,dest)
+ * 
+ * 势函数在不同连通情况下可能只是可采纳而非一致，所以允许已确定的顶点在
+ * 距离变短时重新入队；目标出队时的距离即为最短距离。队列不支持降键时改为
+ * 重复插入，弹出已确定顶点的过期项时跳过。地标须在与graph同类型、同编号的图上
+ * 预处理，否则抛出"Landmarks do not match graph"。
+ * Radix_Heap和Dial_Queue要求键值单调，只能用于强连通图(此时势函数一致)；
+ * Dial_Queue的桶窗口还须覆盖最大约化边权，即最大边权加势函数的跨度。
+ * 
+ * @param graph Graph或CSRGraph
+ * @param landmarks 预处理得到的地标距离表
+ * @param src 起点(原顶点名)
+ * @param dest 终点(原顶点名)
+ * @param queue 优先队列，返回时为空
+ * @param workspace 工作区
+ * @return 最短距离；顶点不存在抛出"Source not found"，不可达抛出"Path Not Found"
+ */
+template<PriorityQueue Queue, SearchGraph GraphT>
+const int astar(const GraphT& graph, const Landmarks& landmarks, const int& src, const int& dest,
+                Queue& queue, DijkstraWorkspace& workspace)
+{
+    int s = graph.index(src), t = graph.index(dest);
+    if(s == -1 || t == -1)
+        throw "Source not found";
+    if(!landmarks.matches(graph))
+        throw "Landmarks do not match graph";
+    workspace.prepare(graph.getBound());
+    workspace.reach(s, 0);
+    queue.insert(landmarks.potential(s, t), s);
+    while(!queue.isEmpty())
+    {
+        int u = 0;
+        if(!queue.minimum(&u))
+            throw "unable to get minimum";
+        queue.removeMin();
+        if constexpr (!supports_decrease_key_v<Queue>)
+        {
+            if(workspace.settled(u))
+                continue;
+        }
+        workspace.settle(u);
+        if(u == t)
+            break;
+        int du = workspace.distance(u);
+        for(const Edge& it : graph.edges(u))
+        {
+            int v = it.dest;
+            int dv = du + it.weight;
+            if(dv < workspace.distance(v))
+            {
+                workspace.reach(v, dv);
+                if constexpr (supports_decrease_key_v<Queue>)
+                    queue.update(v, dv + landmarks.potential(v, t));
+                else
+                    queue.insert(dv + landmarks.potential(v, t), v);
+            }
+        }
+    }
+    if(!queue.isEmpty())
+        queue.destroy();
+    int d = workspace.distance(t);
+    if(d == MAX)
+        throw "Path Not Found";
+    return d;
+}
+
+template<PriorityQueue Queue, SearchGraph GraphT>
+const int astar(const GraphT& graph, const Landmarks& landmarks, const int& src, const int& dest, Queue& queue)
+{
+    DijkstraWorkspace workspace;
+    return astar(graph, landmarks, src, dest, queue, workspace);
+}
+
+#endif
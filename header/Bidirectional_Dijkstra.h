@@ -0,0 +1,132 @@
+#ifndef __BIDIRECTIONAL_DIJKSTRA_H
+#define __BIDIRECTIONAL_DIJKSTRA_H
+
+#include "default.h"
+#include "Dijkstra.h"
+
+using namespace std;
+
+/*
+ * 双向Dijkstra：正向在graph上从src搜索，反向在反图reverse上从dest搜索，两侧交替扩展
+ * 一个顶点。记mu为已发现的最短s-t路径长度，当两侧堆顶距离之和不小于mu时停止，mu即为答案。
+ * reverse须与graph使用相同的顶点编号(Graph::reverse满足)；两个队列须为同一类型，
+ * 可以是任何满足PriorityQueue的堆。工作区版本在查询之间复用距离标签。
+ */
+
+/**
+ * @brief 单侧扩展一步：取出堆顶顶点并松弛它在本侧图中的出边，顺带更新mu
+ *
+ * 队列不支持降键时改为重复插入，弹出已确定顶点的过期项时直接返回。
+ *
+ * @param graph 本侧的图(正向为原图，反向为反图)
+ * @param queue 本侧的队列
+ * @param space 本侧的距离标签
+ * @param other 另一侧的距离标签
+ * @param mu 已发现的最短s-t路径长度
+ */
+template<class Queue, class GraphT>
+void bidirectionalExpand(const GraphT& graph, Queue& queue, DijkstraWorkspace& space,
+                         const DijkstraWorkspace& other, long long& mu)
+{
+    int u = 0;
+    if(!queue.minimum(&u))
+        throw "unable to get minimum";
+    queue.removeMin();
+    if constexpr (!supports_decrease_key_v<Queue>)
+    {
+        if(space.settled(u))
+            return;
+    }
+    space.settle(u);
+    int du = space.distance(u);
+    for(const Edge& it : graph.edges(u))
+    {
+        int v = it.dest;
+        int dv = du + it.weight;
+        if(!space.settled(v) && dv < space.distance(v))
+        {
+            space.reach(v, dv);
+            if constexpr (supports_decrease_key_v<Queue>)
+                queue.update(v, dv);
+            else
+                queue.insert(dv, v);
+        }
+        // 另一侧已到达v，经过(u,v)得到一条候选路径
+        int back = other.distance(v);
+        if(back != MAX && (long long)dv + back < mu)
+            mu = (long long)dv + back;
+    }
+}
+
+/**
+ * @brief 队列堆顶顶点在本侧的距离；惰性队列的过期项给出更小的值，只会让停止判据更保守
+ */
+template<class Queue>
+long long bidirectionalTopKey(Queue& queue, const DijkstraWorkspace& space)
+{
+    int u = 0;
+    if(!queue.minimum(&u))
+        return MAX;
+    return space.distance(u);
+}
+
+/**
+ * @brief 双向点到点最短距离
+ *
+ * @param graph Graph或CSRGraph
+ * @param reverse graph的反图，顶点编号与graph一致
+ * @param src 起点(原顶点名)
+ * @param dest 终点(原顶点名)
+ * @param forward 正向队列
+ * @param backward 反向队列
+ * @param forwardSpace 正向工作区
+ * @param backwardSpace 反向工作区
+ * @return 最短距离；顶点不存在抛出"Source not found"，不可达抛出"Path Not Found"
+ */
+template<PriorityQueue Queue, SearchGraph GraphT>
+const int bidirectionalDijkstra(const GraphT& graph, const GraphT& reverse, const int& src, const int& dest,
+                                Queue& forward, Queue& backward,
+                                DijkstraWorkspace& forwardSpace, DijkstraWorkspace& backwardSpace)
+{
+    int s = graph.index(src), t = graph.index(dest);
+    if(s == -1 || t == -1 || reverse.getBound() < graph.getBound())
+        throw "Source not found";
+    if(s == t)
+        return 0;
+    forwardSpace.prepare(graph.getBound());
+    backwardSpace.prepare(graph.getBound());
+    forwardSpace.reach(s, 0);
+    backwardSpace.reach(t, 0);
+    forward.insert(0, s);
+    backward.insert(0, t);
+    long long mu = MAX;
+    bool turn = true; // true表示轮到正向
+    while(!forward.isEmpty() && !backward.isEmpty())
+    {
+        // 相遇判据：两侧堆顶之和不小于mu时，mu已是最短距离
+        if(bidirectionalTopKey(forward, forwardSpace) + bidirectionalTopKey(backward, backwardSpace) >= mu)
+            break;
+        if(turn)
+            bidirectionalExpand(graph, forward, forwardSpace, backwardSpace, mu);
+        else
+            bidirectionalExpand(reverse, backward, backwardSpace, forwardSpace, mu);
+        turn = !turn;
+    }
+    if(!forward.isEmpty())
+        forward.destroy();
+    if(!backward.isEmpty())
+        backward.destroy();
+    if(mu >= MAX)
+        throw "Path Not Found";
+    return (int)mu;
+}
+
+template<PriorityQueue Queue, SearchGraph GraphT>
+const int bidirectionalDijkstra(const GraphT& graph, const GraphT& reverse, const int& src, const int& dest,
+                                Queue& forward, Queue& backward)
+{
+    DijkstraWorkspace forwardSpace, backwardSpace;
+    return bidirectionalDijkstra(graph, reverse, src, dest, forward, backward, forwardSpace, backwardSpace);
+}
+
+#endif
@@ -3,15 +3,50 @@
 
 #include "default.h"
 
+using namespace std;
+
+/**
+ * @class BHEntry
+ * @brief d叉堆数组中的一个槽位，键值与顶点相邻存放
+ */
+class BHEntry
+{
+public:
+    int key; // 关键字(键值)
+    int vertex; // 顶点
+
+    BHEntry():key(-1), vertex(-1){}
+    BHEntry(int key, int vertex):key(key), vertex(vertex){}
+};
+
+/**
+ * @class Binary_Heap
+ * @brief 基于连续数组的带索引d叉堆，叉数可取2/4/8
+ */
 class Binary_Heap
 {
 private:
-    
+    int shift; // log2(叉数)，用移位代替乘除
+    vector<BHEntry> heap; // 堆数组
+    vector<int> pos; // 顶点 -> 堆中槽位，不在堆中为-1
+
+    void place(int slot, const BHEntry& entry);
+    void siftUp(int slot, BHEntry entry);
+    void siftDown(int slot, BHEntry entry);
+    int search(int vertex);
+
 public:
-    Binary_Heap(/* args */);
+    Binary_Heap(int arity = 4, int capacity = 0);
     ~Binary_Heap();
-};
-
 
+    bool isEmpty();
+    int size();
+    bool minimum(int *pkey);
+    void insert(int key, int vertex);
+    void removeMin();
+    bool contains(int vertex);
+    void update(int vertex, int newkey);
+    void destroy();
+};
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,7 @@
 #define __BIQ_H
 
 #include "default.h"
+#include "Node_Pool.h"
 
 using namespace std;
 
@@ -18,9 +19,10 @@ public:
     BiNode* child; // 左孩子
     BiNode* parent; // 父节点
     BiNode* next; // 兄弟节点
+    unsigned epoch; // 分配时队列的代数，用于识别destroy之后失效的句柄
 
     BiNode():key(-1), vertex(-1), degree(0){}
-    BiNode(int key, int vertex):key(key), vertex(vertex), degree(0), child(nullptr), parent(nullptr), next(nullptr){};
+    BiNode(int key, int vertex):key(key), vertex(vertex), degree(0), child(nullptr), parent(nullptr), next(nullptr), epoch(0){};
 };
 
 /**
@@ -31,6 +33,9 @@ class Binomial_Queue
 {
 private:
     BiNode* mRoot;
+    vector<BiNode*> handles; // 顶点 -> 节点的句柄索引，节点代数不是当前代数时无效
+    NodePool<BiNode> pool; // 节点内存池
+    unsigned epoch; // 每次destroy加1
 
     void link(BiNode* child, BiNode* root); 
     BiNode* merge(BiNode* h1, BiNode* h2);
@@ -40,11 +45,17 @@ private:
     void decreaseKey(BiNode* node, int key);
     void increaseKey(BiNode* node, int key);
     void updateKey(BiNode* node, int key);
-    BiNode* search(BiNode* root, int key);
+    void exchange(BiNode* a, BiNode* b);
+    BiNode* search(int vertex);
+    void restamp(unsigned next);
+    void setHandle(int vertex, BiNode* node);
 
 public:
-    Binomial_Queue():mRoot(nullptr){}
+    Binomial_Queue():mRoot(nullptr), epoch(1){}
+    Binomial_Queue(int capacity):mRoot(nullptr), handles(capacity, nullptr), epoch(1){}
     ~Binomial_Queue(){};
+    Binomial_Queue(const Binomial_Queue&) = delete;
+    Binomial_Queue& operator=(const Binomial_Queue&) = delete;
 
     // 判断是否为空
     bool isEmpty();
@@ -52,8 +63,9 @@ public:
     void combine(Binomial_Queue* other);
     void insert(int key, int vertex);
     void removeMin();
-    bool contains(int key);
+    bool contains(int vertex);
     void update(int vertex, int newkey);
+    void destroy();
 };
 
 #endif
\ No newline at end of file
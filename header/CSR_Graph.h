@@ -0,0 +1,65 @@
+#ifndef __CSR_GRAPH_H
+#define __CSR_GRAPH_H
+
+#include "default.h"
+#include "Dijkstra.h"
+#include <memory>
+
+using namespace std;
+
+class MappedFile;
+
+/**
+ * @class CSRGraph
+ * @brief 压缩稀疏行(CSR)格式的只读图
+ * 
+ * 顶点重新编号为0..V-1，顶点u的出边为arcs[offsets[u], offsets[u+1])，
+ * 终点和权值成对紧密存放。构建完成后不再修改。
+ * 
+ * 查询只通过*View指针访问数据：由文本构建时指向自有的vector，
+ * 由快照加载时直接指向只读映射的文件内容，不做任何解析和拷贝。
+ */
+class CSRGraph{
+private:
+    int V;
+    int E;
+    vector<int> offsets; // 每个顶点出边的起始位置，长度V+1
+    vector<Edge> arcs; // 所有出边，dest为重新编号后的顶点
+    vector<int> names; // 新编号 -> 原顶点名
+    vector<int> ids; // 原顶点名 -> 新编号，不存在为-1
+    shared_ptr<const MappedFile> snapshot; // 快照加载时持有的映射
+
+    const int* offsetView;
+    const Edge* arcView;
+    const int* nameView;
+    const int* idView;
+    int idCount;
+
+    void build(const vector<int>& srcs, const vector<int>& dests, const vector<int>& weights);
+    void bindStorage();
+
+public:
+    CSRGraph():V(0), E(0), offsetView(nullptr), arcView(nullptr), nameView(nullptr), idView(nullptr), idCount(0){};
+    ~CSRGraph(){};
+    CSRGraph(const CSRGraph&) = delete;
+    CSRGraph& operator=(const CSRGraph&) = delete;
+    CSRGraph(CSRGraph&&) = default;
+    CSRGraph& operator=(CSRGraph&&) = default;
+    const CSRGraph& buildFromGraph(const Graph& graph);
+    const CSRGraph& buildFromtxt(const string& filePath);
+    const CSRGraph& buildFromgr(const string& filePath);
+    void saveSnapshot(const string& filePath) const;
+    const CSRGraph& loadSnapshot(const string& filePath, bool verify = true);
+    int getV() const {return V;};
+    int getE() const {return E;};
+    int getBound() const {return V;};
+    int getMaxWeight() const;
+    int index(const int& name) const;
+    int name(const int& u) const {return nameView[u];};
+    EdgeRange edges(const int& u) const
+    {
+        return EdgeRange(arcView + offsetView[u], arcView + offsetView[u + 1]);
+    };
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef __CONTRACTION_HIERARCHY_H
+#define __CONTRACTION_HIERARCHY_H
+
+#include "default.h"
+#include "Dijkstra.h"
+
+using namespace std;
+
+/**
+ * @class ContractionHierarchy
+ * @brief 收缩层次(Contraction Hierarchies)的预处理结果和查询
+ * 
+ * 预处理按边差(edge difference)惰性更新的优先级逐个收缩顶点，用见证搜索判断是否
+ * 需要捷径。查询只沿"向上"的边搜索：正向在upward图上从起点出发，反向在downward图
+ * (原方向为高阶->低阶的边，按低阶端存放)上从终点出发，两侧相遇处即为最短路。
+ * 顶点内部编号为0..V-1，按原顶点名升序，与CSRGraph一致。
+ */
+class ContractionHierarchy
+{
+private:
+    int V;
+    int shortcutCount;
+    vector<int> ids; // 原顶点名 -> 编号，不存在为-1
+    vector<int> rank; // 收缩顺序
+    vector<int> upOffsets; // upward图，CSR
+    vector<Edge> upArcs;
+    vector<int> downOffsets; // downward图，CSR
+    vector<Edge> downArcs;
+
+public:
+    ContractionHierarchy():V(0), shortcutCount(0){};
+    ~ContractionHierarchy(){};
+    const ContractionHierarchy& build(const Graph& graph, int threads = 0);
+    int getV() const {return V;};
+    int getShortcuts() const {return shortcutCount;};
+    int getRank(const int& u) const {return rank[u];};
+    int index(const int& name) const;
+    EdgeRange upward(const int& u) const
+    {
+        return EdgeRange(upArcs.data() + upOffsets[u], upArcs.data() + upOffsets[u + 1]);
+    };
+    EdgeRange downward(const int& u) const
+    {
+        return EdgeRange(downArcs.data() + downOffsets[u], downArcs.data() + downOffsets[u + 1]);
+    };
+    const int query(const int& src, const int& dest) const;
+    const int query(const int& src, const int& dest, Binary_Heap& forward, Binary_Heap& backward,
+                    DijkstraWorkspace& forwardSpace, DijkstraWorkspace& backwardSpace) const;
+};
+
+#endif
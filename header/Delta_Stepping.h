@@ -0,0 +1,56 @@
+#ifndef __DELTA_STEPPING_H
+#define __DELTA_STEPPING_H
+
+#include "default.h"
+#include "CSR_Graph.h"
+#include <atomic>
+#include <memory>
+
+using namespace std;
+
+/**
+ * @class DeltaStepping
+ * @brief 基于CSRGraph的并行Δ-stepping单源最短路
+ *
+ * 按距离把顶点分入宽度为delta的桶，依次处理桶：先反复松弛桶内顶点的轻边(权值<delta)
+ * 直到桶不再有新顶点，再对本桶确定的顶点各松弛一次重边。同一桶内的顶点由所有线程
+ * 并行松弛，距离用CAS取最小值，新到达的顶点先写入线程自己的桶缓冲，每轮结束后汇总。
+ * 得到的是精确最短距离，与dijkstraAll逐项相同。
+ *
+ * 构造时把出边按轻重重排成自己的一份CSR，修改delta会重排。同一对象不能被多个线程
+ * 同时调用run。
+ */
+class DeltaStepping
+{
+private:
+    struct Pending{
+        int v;
+        int dist; // 入桶时的距离，与当前距离不等说明已被更短的距离取代
+    };
+    struct alignas(64) ThreadState{
+        vector<vector<Pending>> bins; // 环形桶缓冲，下标为桶号对binCount取模
+        vector<int> settled; // 当前桶中处理过的顶点，轻边阶段结束后松弛其重边
+    };
+    const CSRGraph& graph;
+    int delta;
+    int threads;
+    int binCount; // 未处理的顶点最多分布在这么多个相邻的桶里
+    vector<int> offsets; // 顶点u的出边为arcs[offsets[u], offsets[u+1])
+    vector<int> lightEnd; // 其中[offsets[u], lightEnd[u])为轻边
+    vector<Edge> arcs;
+    unique_ptr<atomic<int>[]> dist;
+    vector<ThreadState> states;
+
+    void split();
+    void relax(ThreadState& state, int v, int d);
+
+public:
+    DeltaStepping(const CSRGraph& graph, int delta = 0, int threads = 0);
+    ~DeltaStepping(){};
+    void setDelta(int delta);
+    int getDelta() const {return delta;};
+    int getThreads() const {return threads;};
+    vector<int> run(const int& src);
+};
+
+#endif
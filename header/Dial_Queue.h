@@ -0,0 +1,46 @@
+#ifndef __DIAL_QUEUE_H
+#define __DIAL_QUEUE_H
+
+#include "default.h"
+
+using namespace std;
+
+/**
+ * @class Dial_Queue
+ * @brief Dial桶队列：最大边权为C时，队列中的键总落在[cursor, cursor+C]内
+ * 
+ * 用C+1个循环桶，桶内为按顶点编号串起的双向链表(next/prev数组)，插入、降键
+ * 和删除都是O(1)且不分配内存；取最小值时cursor单调前移，一次查询总共扫过
+ * O(最大距离)个桶。键值超出窗口时抛出异常。
+ */
+class Dial_Queue
+{
+private:
+    int width; // 桶数，等于最大边权+1
+    vector<int> heads; // 桶 -> 链表头顶点，空桶为-1
+    vector<int> next; // 顶点 -> 同桶的下一个顶点
+    vector<int> prev; // 顶点 -> 同桶的上一个顶点，链表头为-1
+    vector<int> keys; // 顶点 -> 键值，不在队列中为-1
+    int cursor; // 当前最小键的下界
+    int count;
+
+    void grow(int vertex);
+    void link(int key, int vertex);
+    void unlink(int vertex);
+    void advance();
+
+public:
+    Dial_Queue(int maxWeight, int capacity = 0);
+    ~Dial_Queue();
+
+    bool isEmpty();
+    int size();
+    bool minimum(int *pkey);
+    void insert(int key, int vertex);
+    void removeMin();
+    bool contains(int vertex);
+    void update(int vertex, int newkey);
+    void destroy();
+};
+
+#endif
@@ -3,37 +3,380 @@
 
 #include "default.h"
 #include "Fib_Heap.h"
+#include "Index_Fib_Heap.h"
 #include "Binomial_Queue.h"
+#include "Binary_Heap.h"
+#include "Radix_Heap.h"
+#include "Dial_Queue.h"
+#include "Pairing_Heap.h"
+#include "Rank_Pairing_Heap.h"
+#include "Lazy_Queue.h"
+#include "Priority_Queue.h"
+#include "Search_Stats.h"
 
 using namespace std;
 
+class CSRGraph;
+
 class Edge{
 public:
     int dest;
     int weight;
+    Edge():dest(0), weight(0){};
     Edge(const int& dest, const int& weight):dest(dest), weight(weight){};
-    ~Edge(){};
+};
+
+/**
+ * @class EdgeRange
+ * @brief 一个顶点的出边在连续内存中的区间，Graph和CSRGraph共用
+ */
+class EdgeRange{
+public:
+    const Edge* first;
+    const Edge* last;
+    EdgeRange():first(nullptr), last(nullptr){};
+    EdgeRange(const Edge* first, const Edge* last):first(first), last(last){};
+    const Edge* begin() const {return first;};
+    const Edge* end() const {return last;};
+    int size() const {return last - first;};
 };
 
 class Graph{
 public:
     int V;
     int E;
+    int maxVertex;
     unordered_map<int, vector<Edge>> adjList;
-    Graph():V(0), E(0), adjList({}){};
+    Graph():V(0), E(0), maxVertex(0), adjList({}){};
     ~Graph(){};
     bool addVertex(const int& name);
     bool addEdge(const int& name, Edge& newedge);
     bool addEdge(const int& name, const int& dest, const int& weight);
     int getV() const {return V;};
     int getE() const {return E;};
+    int getBound() const {return maxVertex + 1;};
+    EdgeRange edges(const int& src) const;
+    int getMaxWeight() const;
+    int index(const int& name) const {return name >= 0 && name <= maxVertex ? name : -1;}; // Graph直接用顶点名做编号
+    int name(const int& u) const {return u;};
     int getWeight(const int& src, const int& dest);
     bool alterWeight(const int& src, const int& dest, const int& weight);
     const vector<int>& getNeighbors(const int& src);
     const Graph& buildGraphFromtxt(const string& filePath);
+    const Graph& buildGraphFromgr(const string& filePath);
+    Graph reverse() const;
+};
+
+/**
+ * @class DijkstraWorkspace
+ * @brief 查询之间复用的距离标签，用代数(generation)计数惰性失效
+ * 
+ * 每次prepare只把代数加2，不清零数组：stamp等于当前代数表示已到达、dist有效，
+ * 等于代数+1表示已确定(settled)，其余都视为未到达。因此一次查询的开销只和
+ * 实际访问的顶点数有关，与V无关。
+ */
+class DijkstraWorkspace{
+private:
+    struct Label{
+        int dist;
+        unsigned stamp;
+    };
+    vector<Label> labels; // dist与stamp相邻存放，一次访存同时取到
+    vector<int> parents; // 前驱，只在需要路径时分配和写入
+    vector<unsigned> marks; // 一对多查询的目标标记，等于当前代数即为目标
+    unsigned generation;
+
+public:
+    DijkstraWorkspace():generation(0){};
+    ~DijkstraWorkspace(){};
+    void prepare(int bound);
+    int distance(int v) const {return labels[v].stamp - generation <= 1 ? labels[v].dist : MAX;};
+    bool settled(int v) const {return labels[v].stamp == generation + 1;};
+    void reach(int v, int dist) {labels[v].dist = dist; labels[v].stamp = generation;};
+    void settle(int v) {labels[v].stamp = generation + 1;};
+    void prepareParents(int bound);
+    void reach(int v, int dist, int parent) {reach(v, dist); parents[v] = parent;};
+    int parent(int v) const {return parents[v];};
+    void prepareTargets(int bound);
+    bool markTarget(int v);
+    bool target(int v) const {return marks[v] == generation;};
 };
 
-const int dijkstra(Graph& graph, const int& src, const int& dest, FibHeap& queue);
-const int dijkstra(Graph& graph, const int& src, const int& dest, Binomial_Queue& queue);
+/**
+ * @class QueryResult
+ * @brief 带路径的查询结果：距离和指向工作区前驱数组的视图，路径按需展开
+ * 
+ * 前驱保存在查询所用的DijkstraWorkspace中，结果在该工作区开始下一次查询前有效。
+ */
+class QueryResult{
+private:
+    const DijkstraWorkspace* workspace;
+    const CSRGraph* csr; // 在CSRGraph上查询时用于把编号换回原顶点名，Graph上为nullptr
+    int bound; // 查询所用图的顶点编号上界，超出的顶点名不在图中
+    int s;
+    int t;
+
+public:
+    int distance;
+#ifdef SEARCH_STATS
+    SearchStats stats; // 本次查询的操作计数
+#endif
+    QueryResult():workspace(nullptr), csr(nullptr), bound(0), s(-1), t(-1), distance(MAX){};
+    QueryResult(const DijkstraWorkspace* workspace, const CSRGraph* csr, int bound, int s, int t, int distance)
+        :workspace(workspace), csr(csr), bound(bound), s(s), t(t), distance(distance)
+#ifdef SEARCH_STATS
+        , stats(lastSearchStats())
+#endif
+    {};
+    int predecessor(const int& name) const;
+    vector<int> path() const;
+    vector<Edge> edges() const;
+};
+
+#ifdef SEARCH_STATS
+/**
+ * @brief 记一次入队：支持降键的队列中已有标签的顶点算降键，否则算插入
+ * 
+ * @param fresh 顶点此前是否未被到达
+ */
+template<class Queue>
+void countPush(bool fresh)
+{
+    if(supports_decrease_key_v<Queue> && !fresh)
+        searchStats.decreaseKey();
+    else
+        searchStats.insert();
+}
+#endif
+
+/**
+ * @brief 点到点Dijkstra的公共实现，顶点均为图内编号
+ * 
+ * 距离标签复用工作区，返回前清空队列，使队列可被下一次查询复用。
+ * TrackPath为编译期常量，为false时生成的代码不含任何前驱写入；队列不支持降键时
+ * 改为重复插入，出队时跳过已确定的顶点。
+ * 
+ * @param graph 图
+ * @param s 起点
+ * @param t 终点
+ * @param queue 优先队列
+ * @param workspace 工作区
+ * @return 最短距离，不可达返回MAX
+ */
+template<bool TrackPath, class Queue, class GraphT>
+int shortestPath(const GraphT& graph, int s, int t, Queue& queue, DijkstraWorkspace& workspace)
+{
+    workspace.prepare(graph.getBound());
+    if constexpr (TrackPath)
+    {
+        workspace.prepareParents(graph.getBound());
+        workspace.reach(s, 0, -1);
+    }
+    else
+        workspace.reach(s, 0);
+    SEARCH_STAT(searchStats.reset());
+    queue.insert(0, s);
+    SEARCH_STAT(searchStats.insert());
+    while(!queue.isEmpty())
+    {
+        int u = 0;
+        if(!queue.minimum(&u))
+            throw "unable to get minimum";
+        queue.removeMin();
+        SEARCH_STAT(searchStats.removeMin());
+        if constexpr (!supports_decrease_key_v<Queue>)
+        {
+            if(workspace.settled(u))
+                continue;
+        }
+        workspace.settle(u);
+        SEARCH_STAT(searchStats.settle());
+        if(u == t)
+            break;
+        int du = workspace.distance(u);
+        for(const Edge& it : graph.edges(u))
+        {
+            int v = it.dest;
+            int weight = it.weight;
+            SEARCH_STAT(searchStats.relax());
+            if(!workspace.settled(v) && du + weight < workspace.distance(v))
+            {
+                SEARCH_STAT(countPush<Queue>(workspace.distance(v) == MAX));
+                if constexpr (TrackPath)
+                    workspace.reach(v, du + weight, u);
+                else
+                    workspace.reach(v, du + weight);
+                if constexpr (supports_decrease_key_v<Queue>)
+                    queue.update(v, du + weight);
+                else
+                    queue.insert(du + weight, v);
+            }
+        }
+    }
+    if(!queue.isEmpty())
+        queue.destroy();
+    return workspace.distance(t);
+}
+
+/**
+ * @brief 单源最短路树的公共实现，顶点均为图内编号
+ * 
+ * targets为空指针时扫完整个连通部分(一对全部)；否则在所有目标都确定后提前结束
+ * (一对多)。调用返回后距离留在工作区中，由调用者按需读出。
+ * 
+ * @param graph 图
+ * @param s 起点编号
+ * @param targets 目标编号，不存在的顶点由调用者事先剔除
+ * @param queue 优先队列
+ * @param workspace 工作区
+ */
+template<class Queue, class GraphT>
+void shortestPathTree(const GraphT& graph, int s, const vector<int>* targets, Queue& queue, DijkstraWorkspace& workspace)
+{
+    workspace.prepare(graph.getBound());
+    int remaining = -1;
+    if(targets != nullptr)
+    {
+        workspace.prepareTargets(graph.getBound());
+        remaining = 0;
+        for(int t : *targets)
+            if(workspace.markTarget(t))
+                remaining++;
+        if(remaining == 0)
+            return;
+    }
+    workspace.reach(s, 0);
+    SEARCH_STAT(searchStats.reset());
+    queue.insert(0, s);
+    SEARCH_STAT(searchStats.insert());
+    while(!queue.isEmpty())
+    {
+        int u = 0;
+        if(!queue.minimum(&u))
+            throw "unable to get minimum";
+        queue.removeMin();
+        SEARCH_STAT(searchStats.removeMin());
+        if constexpr (!supports_decrease_key_v<Queue>)
+        {
+            if(workspace.settled(u))
+                continue;
+        }
+        workspace.settle(u);
+        SEARCH_STAT(searchStats.settle());
+        if(remaining > 0 && workspace.target(u) && --remaining == 0)
+            break;
+        int du = workspace.distance(u);
+        for(const Edge& it : graph.edges(u))
+        {
+            int v = it.dest;
+            int weight = it.weight;
+            SEARCH_STAT(searchStats.relax());
+            if(!workspace.settled(v) && du + weight < workspace.distance(v))
+            {
+                SEARCH_STAT(countPush<Queue>(workspace.distance(v) == MAX));
+                workspace.reach(v, du + weight);
+                if constexpr (supports_decrease_key_v<Queue>)
+                    queue.update(v, du + weight);
+                else
+                    queue.insert(du + weight, v);
+            }
+        }
+    }
+    if(!queue.isEmpty())
+        queue.destroy();
+}
+
+/**
+ * @brief 点到点最短距离
+ * 
+ * @param graph Graph或CSRGraph
+ * @param src 起点(原顶点名)
+ * @param dest 终点(原顶点名)
+ * @param queue 优先队列，返回时为空
+ * @param workspace 工作区
+ * @return 最短距离；顶点不存在抛出"Source not found"，不可达抛出"Path Not Found"
+ */
+template<PriorityQueue Queue, SearchGraph GraphT>
+const int dijkstra(const GraphT& graph, const int& src, const int& dest, Queue& queue, DijkstraWorkspace& workspace)
+{
+    int s = graph.index(src), t = graph.index(dest);
+    if(s == -1 || t == -1)
+        throw "Source not found";
+    int d = shortestPath<false>(graph, s, t, queue, workspace);
+    if(d == MAX)
+        throw "Path Not Found";
+    return d;
+}
+
+template<PriorityQueue Queue, SearchGraph GraphT>
+const int dijkstra(const GraphT& graph, const int& src, const int& dest, Queue& queue)
+{
+    DijkstraWorkspace workspace;
+    return dijkstra(graph, src, dest, queue, workspace);
+}
+
+/**
+ * @brief 带前驱记录的点到点查询，路径由QueryResult按需展开
+ */
+template<PriorityQueue Queue, SearchGraph GraphT>
+const QueryResult dijkstraPath(const GraphT& graph, const int& src, const int& dest, Queue& queue, DijkstraWorkspace& workspace)
+{
+    int s = graph.index(src), t = graph.index(dest);
+    if(s == -1 || t == -1)
+        throw "Source not found";
+    int d = shortestPath<true>(graph, s, t, queue, workspace);
+    if(d == MAX)
+        throw "Path Not Found";
+    const CSRGraph* csr = nullptr;
+    if constexpr (is_same_v<GraphT, CSRGraph>)
+        csr = &graph;
+    return QueryResult(&workspace, csr, graph.getBound(), s, t, d);
+}
+
+/**
+ * @brief 一对全部查询
+ * 
+ * @return 以图内编号为下标的距离数组，长度为getBound()，不可达为MAX；
+ *         Graph的编号就是顶点名，CSRGraph可用index()换算
+ */
+template<PriorityQueue Queue, SearchGraph GraphT>
+const vector<int> dijkstraAll(const GraphT& graph, const int& src, Queue& queue, DijkstraWorkspace& workspace)
+{
+    int s = graph.index(src);
+    if(s == -1)
+        throw "Source not found";
+    shortestPathTree(graph, s, nullptr, queue, workspace);
+    vector<int> dist(graph.getBound());
+    for(int v = 0; v < graph.getBound(); v++)
+        dist[v] = workspace.distance(v);
+    return dist;
+}
+
+/**
+ * @brief 一对多查询，所有目标确定后提前结束
+ * 
+ * @return 与dests一一对应的距离，不可达或不存在的目标为MAX
+ */
+template<PriorityQueue Queue, SearchGraph GraphT>
+const vector<int> dijkstraMany(const GraphT& graph, const int& src, const vector<int>& dests, Queue& queue, DijkstraWorkspace& workspace)
+{
+    int s = graph.index(src);
+    if(s == -1)
+        throw "Source not found";
+    vector<int> ids(dests.size()), targets;
+    targets.reserve(dests.size());
+    for(size_t i = 0; i < dests.size(); i++)
+    {
+        ids[i] = graph.index(dests[i]);
+        if(ids[i] != -1)
+            targets.push_back(ids[i]);
+    }
+    shortestPathTree(graph, s, &targets, queue, workspace);
+    vector<int> dist(dests.size(), MAX);
+    for(size_t i = 0; i < dests.size(); i++)
+        if(ids[i] != -1)
+            dist[i] = workspace.distance(ids[i]);
+    return dist;
+}
 
-#endif
\ No newline at end of file
+#endif
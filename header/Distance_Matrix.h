@@ -0,0 +1,42 @@
+#ifndef __DISTANCE_MATRIX_H
+#define __DISTANCE_MATRIX_H
+
+#include "default.h"
+#include "Dijkstra.h"
+#include "Contraction_Hierarchy.h"
+
+using namespace std;
+
+/**
+ * @class DistanceMatrix
+ * @brief 基于收缩层次和桶(bucket)的多对多距离表
+ * 
+ * 先从每个终点在downward图上做向上的反向搜索，把(终点, 距离)记入经过顶点的桶；
+ * 再从每个起点在upward图上做向上的正向搜索，扫描所到顶点的桶即得一整行。
+ * 两个阶段都按起点/终点分给多个线程，每个线程持有自己的工作区和堆，在各次
+ * compute之间复用。同一对象不能被多个线程同时调用compute。
+ */
+class DistanceMatrix
+{
+private:
+    struct BucketEntry{
+        int target; // 终点在targets中的下标
+        int dist;
+    };
+    const ContractionHierarchy& ch;
+    int threads;
+    vector<DijkstraWorkspace> workspaces; // 每个线程一个
+    vector<Binary_Heap> queues; // 每个线程一个
+    vector<int> bucketOffsets; // 桶，按顶点编号的CSR
+    vector<BucketEntry> buckets;
+
+    void fillBuckets(const vector<int>& targets);
+
+public:
+    DistanceMatrix(const ContractionHierarchy& ch, int threads = 0);
+    ~DistanceMatrix(){};
+    int getThreads() const {return threads;};
+    vector<int> compute(const vector<int>& sources, const vector<int>& targets);
+};
+
+#endif
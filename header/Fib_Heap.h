@@ -2,6 +2,7 @@
 #define _FIBONACCI_TREE_HPP_
 
 #include "default.h"
+#include "Node_Pool.h"
 
 using namespace std;
 
@@ -15,9 +16,10 @@ class FibNode {
         FibNode *child;    // 第一个孩子节点
         FibNode *parent;    // 父节点
         bool marked;        // 是否被删除第一个孩子
+        unsigned epoch;     // 分配时堆的代数，用于识别destroy之后失效的句柄
 
         FibNode(int value, int vertex):key(value), vertex(vertex), degree(0), marked(false),
-            left(NULL),right(NULL),child(NULL),parent(NULL) 
+            left(NULL),right(NULL),child(NULL),parent(NULL),epoch(0) 
         {
             left = this;
             right = this;
@@ -27,12 +29,17 @@ class FibNode {
 class FibHeap{
     private:
         int keyNum;         // 堆中节点的总数
-        int maxDegree;      // 最大度
         FibNode *min;    // 最小节点(某个最小堆的根节点)
-        FibNode **cons;    // 最大度的内存区域
+        vector<FibNode*> cons;    // 按度数合并用的表，按容量一次分配，两次合并之间全为空
+        unsigned long long occupied; // cons中非空槽位的位图
+        int consLimit;      // cons按多少个节点的度数上界分配
+        vector<FibNode*> handles; // 顶点 -> 节点的句柄索引，节点代数不是当前代数时无效
+        NodePool<FibNode> pool; // 节点内存池
+        unsigned epoch; // 每次destroy加1
 
     public:
         FibHeap();
+        FibHeap(int capacity);
         ~FibHeap();
 
         bool isEmpty();
@@ -41,7 +48,7 @@ class FibHeap{
         void combine(FibHeap *other);
         bool minimum(int *pkey);
         void update(int vertex, int newkey);
-        void remove(int key);
+        void remove(int vertex);
         bool contains(int vertex);
         void destroy();
 
@@ -52,18 +59,18 @@ class FibHeap{
         void insert(FibNode *node);
         FibNode* extractMin();
         void link(FibNode* node, FibNode* root);
+        static int degreeBound(int n);
         void makeCons();
         void consolidate();
-        void renewDegree(FibNode *parent, int degree);
         void cut(FibNode *node, FibNode *parent);
         void cascadingCut(FibNode *node) ;
         void decrease(FibNode *node, int key);
         void increase(FibNode *node, int key);
         void update(FibNode *node, int key);
-        FibNode* search(FibNode *root, int vertex);
         FibNode* search(int vertex);
+        void setHandle(int vertex, FibNode *node);
         void remove(FibNode *node);
-        void destroyNode(FibNode *node);
+        void restamp(unsigned next);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,53 @@
+#ifndef __LAZY_QUEUE_H
+#define __LAZY_QUEUE_H
+
+#include "default.h"
+#include "Binary_Heap.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @class Lazy_Queue
+ * @brief 不支持降键的二叉堆(std::push_heap/pop_heap)，同一顶点可多次入队
+ * 
+ * 没有update，dijkstra按supports_decrease_key走惰性删除路径：每次松弛都插入，
+ * 出队时跳过已确定的顶点。作为基准对照带索引的堆。
+ */
+class Lazy_Queue
+{
+private:
+    struct Greater{
+        bool operator()(const BHEntry& a, const BHEntry& b) const {return a.key > b.key;};
+    };
+    vector<BHEntry> heap;
+
+public:
+    Lazy_Queue(int capacity = 0) {heap.reserve(capacity);};
+    ~Lazy_Queue(){};
+
+    bool isEmpty() {return heap.empty();};
+    int size() {return heap.size();};
+    bool minimum(int *pkey)
+    {
+        if(heap.empty() || pkey == nullptr)
+            return false;
+        *pkey = heap.front().vertex;
+        return true;
+    };
+    void insert(int key, int vertex)
+    {
+        heap.push_back(BHEntry(key, vertex));
+        push_heap(heap.begin(), heap.end(), Greater());
+    };
+    void removeMin()
+    {
+        if(heap.empty())
+            return;
+        pop_heap(heap.begin(), heap.end(), Greater());
+        heap.pop_back();
+    };
+    void destroy() {heap.clear();};
+};
+
+#endif
@@ -0,0 +1,115 @@
+#ifndef __NODE_POOL_H
+#define __NODE_POOL_H
+
+#include "default.h"
+#include <new>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * @class NodePool
+ * @brief 堆节点的分块内存池：按块批量申请，空闲链表回收，reset整体复用
+ * 
+ * 节点在块内顺序切分，释放的节点进入空闲链表优先复用；reset只把游标拨回第一块，
+ * 不逐个析构也不归还内存，因此要求节点可平凡析构。池不可复制，可移动。
+ * 块的大小固定，不随顶点数变化：短查询只用到很少的节点，按顶点数定块长会在
+ * 第一次插入时就占用整图大小的内存。
+ */
+template<class T>
+class NodePool
+{
+private:
+    static_assert(is_trivially_destructible<T>::value, "pooled nodes must be trivially destructible");
+    struct Block{
+        T* nodes;
+        size_t size;
+    };
+    vector<Block> blocks;
+    size_t blockSize; // 新块的节点数
+    size_t block; // 当前切分的块
+    size_t used; // 当前块已切出的节点数
+    vector<T*> freeNodes;
+
+public:
+    static const size_t DEFAULT_BLOCK = 4096;
+
+    NodePool(size_t blockSize = DEFAULT_BLOCK):blockSize(max<size_t>(blockSize, 16)), block(0), used(0){};
+    ~NodePool()
+    {
+        for(Block& b : blocks)
+            ::operator delete(b.nodes);
+    };
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool(NodePool&& other) noexcept:blockSize(other.blockSize), block(0), used(0) {swap(other);};
+    NodePool& operator=(NodePool&& other) noexcept {swap(other); return *this;};
+
+    void swap(NodePool& other) noexcept
+    {
+        blocks.swap(other.blocks);
+        std::swap(blockSize, other.blockSize);
+        std::swap(block, other.block);
+        std::swap(used, other.used);
+        freeNodes.swap(other.freeNodes);
+    };
+
+    /**
+     * @brief 取一个节点并用args构造
+     */
+    template<class... Args>
+    T* alloc(Args&&... args)
+    {
+        T* slot;
+        if(!freeNodes.empty())
+        {
+            slot = freeNodes.back();
+            freeNodes.pop_back();
+        }
+        else
+        {
+            if(block < blocks.size() && used == blocks[block].size)
+            {
+                block++;
+                used = 0;
+            }
+            if(block == blocks.size())
+                blocks.push_back(Block{static_cast<T*>(::operator new(sizeof(T) * blockSize)), blockSize});
+            slot = blocks[block].nodes + used++;
+        }
+        return new (slot) T(std::forward<Args>(args)...);
+    };
+
+    /**
+     * @brief 归还单个节点
+     */
+    void release(T* node) {freeNodes.push_back(node);};
+
+    /**
+     * @brief 一次性回收全部节点，保留已申请的块
+     */
+    void reset()
+    {
+        block = 0;
+        used = 0;
+        freeNodes.clear();
+    };
+
+    /**
+     * @brief 接管另一个池的全部内存(合并堆时节点随之转移)，other变为空池
+     * 
+     * other的块仍有节点在用，插到当前块之前，reset之前不会被再次切分。
+     */
+    void adopt(NodePool& other)
+    {
+        blocks.insert(blocks.begin() + block, other.blocks.begin(), other.blocks.end());
+        block += other.blocks.size();
+        freeNodes.insert(freeNodes.end(), other.freeNodes.begin(), other.freeNodes.end());
+        other.blocks.clear();
+        other.freeNodes.clear();
+        other.block = 0;
+        other.used = 0;
+    };
+};
+
+#endif
@@ -0,0 +1,60 @@
+#ifndef __PAIRING_HEAP_H
+#define __PAIRING_HEAP_H
+
+#include "default.h"
+#include "Node_Pool.h"
+
+using namespace std;
+
+/**
+ * @class PairNode
+ * @brief 配对堆节点，孩子用"首孩子-兄弟"链表表示
+ */
+class PairNode
+{
+public:
+    int key; // 关键字(键值)
+    int vertex; // 顶点
+    PairNode *child; // 第一个孩子
+    PairNode *next; // 右兄弟
+    PairNode *prev; // 左兄弟，是第一个孩子时指向父节点
+
+    PairNode(int key, int vertex):key(key), vertex(vertex), child(nullptr), next(nullptr), prev(nullptr){}
+};
+
+/**
+ * @class Pairing_Heap
+ * @brief 配对堆，删除最小值时两趟合并(two-pass)，降键时剪下子树与根合并
+ */
+class Pairing_Heap
+{
+private:
+    PairNode *root;
+    int keyNum;
+    vector<PairNode*> handles; // 顶点 -> 节点的句柄索引
+    vector<PairNode*> pairs; // 两趟合并的临时数组，跨调用复用
+    NodePool<PairNode> pool;
+
+    PairNode* meld(PairNode *a, PairNode *b);
+    void cut(PairNode *node);
+    PairNode* mergePairs(PairNode *first);
+    PairNode* search(int vertex);
+    void setHandle(int vertex, PairNode *node);
+
+public:
+    Pairing_Heap(int capacity = 0);
+    ~Pairing_Heap();
+    Pairing_Heap(const Pairing_Heap&) = delete;
+    Pairing_Heap& operator=(const Pairing_Heap&) = delete;
+
+    bool isEmpty();
+    int size();
+    bool minimum(int *pkey);
+    void insert(int key, int vertex);
+    void removeMin();
+    bool contains(int vertex);
+    void update(int vertex, int newkey);
+    void destroy();
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef __PRIORITY_QUEUE_H
+#define __PRIORITY_QUEUE_H
+
+#include "default.h"
+#include <concepts>
+#include <type_traits>
+
+using namespace std;
+
+/**
+ * @brief dijkstra可用的优先队列：键值为int，元素为顶点编号
+ * 
+ * 需要isEmpty/minimum/insert/removeMin/destroy；update(降键)可选，由
+ * supports_decrease_key在编译期区分。新的堆只要满足这些签名即可直接用于
+ * dijkstra系列模板，无需再写重载。
+ */
+template<class Q>
+concept PriorityQueue = requires(Q& queue, int key, int vertex, int* pvertex)
+{
+    {queue.isEmpty()} -> convertible_to<bool>;
+    {queue.minimum(pvertex)} -> convertible_to<bool>;
+    queue.insert(key, vertex);
+    queue.removeMin();
+    queue.destroy();
+};
+
+/**
+ * @brief 队列是否支持按顶点降键；不支持时dijkstra改为重复插入，出队时跳过已确定的顶点
+ */
+template<class Q>
+struct supports_decrease_key : bool_constant<requires(Q& queue, int vertex, int key){queue.update(vertex, key);}> {};
+
+template<class Q>
+inline constexpr bool supports_decrease_key_v = supports_decrease_key<Q>::value;
+
+/**
+ * @brief dijkstra可用的图：顶点编号为0..getBound()-1，index/name在原顶点名和编号间转换
+ */
+template<class G>
+concept SearchGraph = requires(const G& graph, int u)
+{
+    {graph.getBound()} -> convertible_to<int>;
+    {graph.index(u)} -> convertible_to<int>;
+    {graph.name(u)} -> convertible_to<int>;
+    graph.edges(u).begin();
+    graph.edges(u).end();
+};
+
+#endif
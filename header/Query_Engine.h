@@ -0,0 +1,50 @@
+#ifndef __QUERY_ENGINE_H
+#define __QUERY_ENGINE_H
+
+#include "default.h"
+#include "Dijkstra.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+using namespace std;
+
+/**
+ * @class BatchQueryEngine
+ * @brief 多线程批量点到点查询
+ * 
+ * 线程池在构造时创建，每个线程持有自己的DijkstraWorkspace和Binary_Heap，
+ * 在各批次之间复用；图只读共享。结果按输入顺序返回，不可达为INF。
+ */
+class BatchQueryEngine
+{
+private:
+    const Graph& graph;
+    vector<thread> workers;
+    vector<DijkstraWorkspace> workspaces; // 每个线程一个
+    vector<Binary_Heap> queues; // 每个线程一个
+
+    const vector<pair<int, int>>* batch; // 当前批次
+    vector<int>* results;
+    atomic<size_t> nextQuery; // 下一个待领取的查询下标
+    int pending; // 当前批次尚未完成的线程数
+    unsigned long long generation; // 批次编号，用于唤醒线程
+    bool stopping;
+    mutex stateLock;
+    mutex batchLock; // 串行化并发的query调用
+    condition_variable wake;
+    condition_variable done;
+
+    void work(int id);
+
+public:
+    BatchQueryEngine(const Graph& graph, int threads = 0);
+    ~BatchQueryEngine();
+    BatchQueryEngine(const BatchQueryEngine&) = delete;
+    BatchQueryEngine& operator=(const BatchQueryEngine&) = delete;
+    int getThreads() const {return workers.size();};
+    vector<int> query(const vector<pair<int, int>>& queries);
+};
+
+#endif
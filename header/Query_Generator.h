@@ -0,0 +1,55 @@
+#ifndef _QUERY_GENERATOR_H_
+#define _QUERY_GENERATOR_H_
+
+#include "default.h"
+#include "CSR_Graph.h"
+#include "Dijkstra.h"
+
+using namespace std;
+
+/**
+ * @class Query
+ * @brief 一条点到点查询，顶点为原顶点名
+ *
+ * stratum为所属层：按Dijkstra秩生成时为k(秩为2^k)，按地理距离生成时为floor(log2(米))，
+ * 均匀随机生成时为-1。
+ */
+struct Query{
+    int src;
+    int dest;
+    int stratum;
+};
+
+/**
+ * @class QueryGenerator
+ * @brief 由种子确定的查询集生成器
+ *
+ * 随机数只用mt19937的原始输出，不经过实现相关的分布类，同一种子在不同编译器和平台上
+ * 生成相同的查询集。生成的查询集可写入文件，供benchmark和main复现。
+ */
+class QueryGenerator{
+private:
+    const CSRGraph& graph;
+    mt19937 rng;
+    vector<int> lon; // 按CSR编号存放的经度*10^6，未加载坐标时为空
+    vector<int> lat; // 纬度*10^6
+    Binary_Heap queue;
+    DijkstraWorkspace workspace;
+
+    int pick(int n);
+    double geoDistance(int u, int v) const;
+
+public:
+    QueryGenerator(const CSRGraph& graph, unsigned seed);
+    ~QueryGenerator(){};
+    void loadCoordinates(const string& filePath);
+    bool hasCoordinates() const {return !lon.empty();};
+    vector<Query> random(int count);
+    vector<Query> byRank(int sources, int minRank = 1);
+    vector<Query> byDistance(int sources);
+
+    static void save(const string& filePath, const vector<Query>& queries, const string& comment);
+    static vector<Query> load(const string& filePath);
+};
+
+#endif
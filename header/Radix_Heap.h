@@ -0,0 +1,47 @@
+#ifndef __RADIX_HEAP_H
+#define __RADIX_HEAP_H
+
+#include "default.h"
+#include "Binary_Heap.h"
+
+using namespace std;
+
+/**
+ * @class Radix_Heap
+ * @brief 单调整数优先队列(基数堆)，键值不得小于最近一次取出的最小值
+ * 
+ * 第0个桶存放等于last的键，第i个桶存放与last的最高不同位为第i-1位的键。
+ * 第0个桶取空时，把第一个非空桶按新的最小值重新分配到更低的桶里，每个元素至多
+ * 下移32次，因此均摊O(log C)。每个顶点记录所在桶和桶内下标，降键时O(1)摘除。
+ */
+class Radix_Heap
+{
+private:
+    static const int BUCKETS = 33;
+    vector<BHEntry> buckets[BUCKETS];
+    vector<int> where; // 顶点 -> 所在桶，不在堆中为-1
+    vector<int> pos; // 顶点 -> 桶内下标
+    int last; // 最近一次取出的最小键
+    int count;
+
+    int bucketOf(int key) const {return key == last ? 0 : 32 - __builtin_clz((unsigned)(key ^ last));};
+    void grow(int vertex);
+    void push(int key, int vertex);
+    void erase(int vertex);
+    void refill();
+
+public:
+    Radix_Heap(int capacity = 0);
+    ~Radix_Heap();
+
+    bool isEmpty();
+    int size();
+    bool minimum(int *pkey);
+    void insert(int key, int vertex);
+    void removeMin();
+    bool contains(int vertex);
+    void update(int vertex, int newkey);
+    void destroy();
+};
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef __RANK_PAIRING_HEAP_H
+#define __RANK_PAIRING_HEAP_H
+
+#include "default.h"
+#include "Node_Pool.h"
+
+using namespace std;
+
+/**
+ * @class RPNode
+ * @brief 秩配对堆节点，以半树(half-tree)的二叉形式存放：left为第一个孩子，right为下一个兄弟
+ */
+class RPNode
+{
+public:
+    int key; // 关键字(键值)
+    int vertex; // 顶点
+    int rank; // 秩
+    RPNode *left; // 左孩子
+    RPNode *right; // 右孩子，根节点的右孩子恒为空
+    RPNode *parent; // 父节点，根为空
+
+    RPNode(int key, int vertex):key(key), vertex(vertex), rank(0), left(nullptr), right(nullptr), parent(nullptr){}
+};
+
+/**
+ * @class Rank_Pairing_Heap
+ * @brief 类型2秩配对堆(rank-pairing heap, Haeupler-Sen-Tarjan)
+ * 
+ * 根为一组半树，插入和降键O(1)：降键把节点连同左子树剪成新根，其右子树补位，
+ * 再沿祖先按类型2规则降秩。删除最小值时把最小根的左脊拆成新根，与其他根按秩
+ * 一趟配对(one-pass)。
+ */
+class Rank_Pairing_Heap
+{
+private:
+    RPNode *min;
+    int keyNum;
+    vector<RPNode*> roots; // 根列表，min也在其中
+    vector<RPNode*> buckets; // 按秩配对的临时数组，跨调用复用
+    vector<RPNode*> handles; // 顶点 -> 节点的句柄索引
+    NodePool<RPNode> pool;
+
+    static int rankOf(RPNode *node) {return node == nullptr ? -1 : node->rank;};
+    RPNode* link(RPNode *a, RPNode *b);
+    void decrease(RPNode *node, int key);
+    void extract(RPNode *node);
+    RPNode* search(int vertex);
+    void setHandle(int vertex, RPNode *node);
+
+public:
+    Rank_Pairing_Heap(int capacity = 0);
+    ~Rank_Pairing_Heap();
+    Rank_Pairing_Heap(const Rank_Pairing_Heap&) = delete;
+    Rank_Pairing_Heap& operator=(const Rank_Pairing_Heap&) = delete;
+
+    bool isEmpty();
+    int size();
+    bool minimum(int *pkey);
+    void insert(int key, int vertex);
+    void removeMin();
+    bool contains(int vertex);
+    void update(int vertex, int newkey);
+    void destroy();
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef _SEARCH_STATS_H_
+#define _SEARCH_STATS_H_
+
+/**
+ * @file Search_Stats.h
+ * @brief 可选的热路径计数器，编译时定义SEARCH_STATS才生效(make STATS=1)
+ *
+ * 未定义时SEARCH_STAT(...)展开为空，参数不求值，搜索循环和各个堆的代码与不插桩时完全相同；
+ * 线程计数器、lastSearchStats()和QueryResult::stats也都不存在，只保留SearchStats类型供报表使用。
+ * 计数器按线程存放，每次查询开始时清零，查询结束后由QueryResult复制或经lastSearchStats()读取。
+ */
+
+/**
+ * @class SearchStats
+ * @brief 一次查询的操作计数
+ */
+struct SearchStats{
+    unsigned long long inserts = 0; // 堆插入
+    unsigned long long decreaseKeys = 0; // 堆降键
+    unsigned long long removeMins = 0; // 堆删除最小，含惰性删除时弹出的过期项
+    unsigned long long links = 0; // 堆内两棵树的链接
+    unsigned long long cuts = 0; // 堆内子树的剪切
+    unsigned long long settled = 0; // 确定的顶点
+    unsigned long long relaxed = 0; // 松弛检查的边
+    unsigned long long maxHeapSize = 0; // 查询过程中堆的最大元素数
+    unsigned long long heapSize = 0; // 当前元素数，用于求maxHeapSize
+
+    void reset() {*this = SearchStats();};
+    void insert()
+    {
+        inserts++;
+        if(++heapSize > maxHeapSize)
+            maxHeapSize = heapSize;
+    };
+    void decreaseKey() {decreaseKeys++;};
+    void removeMin() {removeMins++; heapSize--;};
+    void link() {links++;};
+    void cut() {cuts++;};
+    void settle() {settled++;};
+    void relax() {relaxed++;};
+};
+
+#ifdef SEARCH_STATS
+/**
+ * @brief 当前线程的计数器
+ */
+inline thread_local SearchStats searchStats;
+
+/**
+ * @brief 当前线程最近一次查询的计数
+ */
+inline const SearchStats& lastSearchStats() {return searchStats;}
+
+#define SEARCH_STAT(stmt) (stmt)
+#else
+#define SEARCH_STAT(stmt) ((void)0)
+#endif
+
+#endif
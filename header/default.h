@@ -13,7 +13,7 @@
 #include <cstdlib>
 #include <cmath> 
 #include <random>
-#include <windows.h>
+#include <chrono>
 
 const int INF = -1;
 const int MAX = 2147483647;
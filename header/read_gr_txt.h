@@ -1,6 +1,92 @@
 #ifndef __R_H
 #define __R_H
 
+#include "default.h"
+
+using namespace std;
+
 void gr2txt();
 
-#endif
\ No newline at end of file
+/**
+ * @class MappedFile
+ * @brief 只读内存映射文件，析构时自动解除映射
+ */
+class MappedFile
+{
+private:
+    const char* data;
+    size_t length;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mapHandle;
+#else
+    int fd;
+#endif
+
+public:
+    MappedFile(const string& filePath, bool sequential = true);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    const char* begin() const {return data;};
+    const char* end() const {return data + length;};
+    size_t size() const {return length;};
+};
+
+/**
+ * @class DimacsReader
+ * @brief DIMACS文本文件的公共解析：在映射内存上逐行扫描，供.gr和.co读取器共用
+ */
+class DimacsReader
+{
+protected:
+    MappedFile file;
+    const char* cur;
+
+    DimacsReader(const string& filePath);
+    void skipLine();
+    void skipProblemLine();
+    int parseInt(bool allowNegative = false);
+    bool nextLine(char tag);
+};
+
+/**
+ * @class GrReader
+ * @brief 在映射内存上直接解析DIMACS .gr文件，不经过中间.txt
+ * 
+ * 构造时读取"p sp n m"头部得到顶点数和弧数，之后用next()逐条取出"a u v w"弧。
+ */
+class GrReader : public DimacsReader
+{
+private:
+    int V;
+    int E;
+
+public:
+    GrReader(const string& filePath);
+    ~GrReader(){};
+    int getV() const {return V;};
+    int getE() const {return E;};
+    bool next(int& src, int& dest, int& weight);
+};
+
+/**
+ * @class CoReader
+ * @brief 解析DIMACS .co坐标文件
+ * 
+ * 构造时读取"p aux sp co n"头部得到顶点数，之后用next()逐条取出"v id x y"，
+ * x、y为经度和纬度乘以10^6后的整数，可为负。
+ */
+class CoReader : public DimacsReader
+{
+private:
+    int V;
+
+public:
+    CoReader(const string& filePath);
+    ~CoReader(){};
+    int getV() const {return V;};
+    bool next(int& id, int& x, int& y);
+};
+
+#endif
@@ -0,0 +1,354 @@
+#include "default.h"
+#include "ALT.h"
+#include <cstdint>
+#include <cstring>
+#include <climits>
+
+using namespace std;
+
+static const char ALT_MAGIC[8] = {'D', 'W', 'H', 'A', 'L', 'T', '\0', '\0'};
+static const int32_t ALT_VERSION = 2; // 版本2在头部增加编号方式，版本1的文件均按顶点名编号
+
+/**
+ * @class ReverseArcs
+ * @brief 预处理用的反图，按CSR存放，Graph和CSRGraph共用
+ */
+class ReverseArcs
+{
+private:
+    int bound;
+    vector<int> offsets;
+    vector<Edge> arcs;
+
+public:
+    template<class GraphT>
+    explicit ReverseArcs(const GraphT& graph):bound(graph.getBound()), offsets(graph.getBound() + 1, 0)
+    {
+        for(int u = 0; u < bound; u++)
+            for(const Edge& edge : graph.edges(u))
+                offsets[edge.dest + 1]++;
+        for(int v = 0; v < bound; v++)
+            offsets[v + 1] += offsets[v];
+        arcs.resize(offsets[bound]);
+        vector<int> fill(offsets.begin(), offsets.end() - 1);
+        for(int u = 0; u < bound; u++)
+            for(const Edge& edge : graph.edges(u))
+                arcs[fill[edge.dest]++] = Edge(u, edge.weight);
+    };
+    int getBound() const {return bound;};
+    EdgeRange edges(const int& u) const {return EdgeRange(arcs.data() + offsets[u], arcs.data() + offsets[u + 1]);};
+};
+
+/**
+ * @brief 单源最短路树，可选记录父节点和确定顺序
+ * 
+ * @param graph 图
+ * @param root 根
+ * @param dist 输出的距离，不可达为MAX
+ * @param parent 输出的父节点，根和不可达顶点为-1，可为nullptr
+ * @param order 输出的顶点确定顺序，可为nullptr
+ */
+template<class GraphT>
+static void shortestPathTree(const GraphT& graph, int root, vector<int>& dist, vector<int>* parent, vector<int>* order)
+{
+    int bound = graph.getBound();
+    dist.assign(bound, MAX);
+    if(parent != nullptr)
+        parent->assign(bound, -1);
+    if(order != nullptr)
+        order->clear();
+    vector<bool> settled(bound, false);
+    Binary_Heap queue(4, bound);
+    dist[root] = 0;
+    queue.insert(0, root);
+    while(!queue.isEmpty())
+    {
+        int u = 0;
+        queue.minimum(&u);
+        queue.removeMin();
+        settled[u] = true;
+        if(order != nullptr)
+            order->push_back(u);
+        for(const Edge& it : graph.edges(u))
+        {
+            int v = it.dest;
+            if(!settled[v] && dist[u] + it.weight < dist[v])
+            {
+                dist[v] = dist[u] + it.weight;
+                if(parent != nullptr)
+                    (*parent)[v] = u;
+                queue.update(v, dist[v]);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 预处理：选取count个地标并计算距离表，距离表按Graph的顶点名编号
+ * 
+ * @param graph 图
+ * @param count 地标个数，超过顶点数时取顶点数
+ * @param method 地标选择策略
+ * @param seed 随机种子，相同种子得到相同的地标
+ * @return 预处理结果
+ */
+const Landmarks& Landmarks::build(const Graph& graph, int count, LandmarkSelection method, unsigned seed)
+{
+    buildFrom(graph, count, method, seed);
+    return *this;
+}
+
+/**
+ * @brief 同上，距离表按CSRGraph的压缩编号，只能用于CSRGraph上的查询
+ */
+const Landmarks& Landmarks::build(const CSRGraph& graph, int count, LandmarkSelection method, unsigned seed)
+{
+    buildFrom(graph, count, method, seed);
+    return *this;
+}
+
+template<class GraphT>
+void Landmarks::buildFrom(const GraphT& graph, int count, LandmarkSelection method, unsigned seed)
+{
+    if(count <= 0)
+        throw "Landmark count must be positive";
+    bound = graph.getBound();
+    numbering = numberingOf<GraphT>();
+    // 有出边或入边的顶点才参与选择，Graph中编号上界以内可能有空缺的顶点名
+    vector<bool> present(bound, false);
+    for(int u = 0; u < bound; u++)
+        for(const Edge& edge : graph.edges(u))
+        {
+            present[u] = true;
+            present[edge.dest] = true;
+        }
+    vector<int> vertices;
+    for(int v = 0; v < bound; v++)
+        if(present[v])
+            vertices.push_back(v);
+    if(vertices.empty())
+        throw "Empty graph";
+    k = min(count, (int)vertices.size());
+    landmarks.clear();
+    fromTable.assign((size_t)bound * k, MAX);
+    toTable.assign((size_t)bound * k, MAX);
+
+    ReverseArcs reverse(graph);
+    mt19937 rng(seed);
+    vector<int> from, to;
+    while((int)landmarks.size() < k)
+    {
+        int next = method == AVOID ? selectAvoid(graph, vertices, rng) : selectFarthest(graph, vertices, rng);
+        if(next == -1)
+            next = selectFarthest(graph, vertices, rng);
+        shortestPathTree(graph, next, from, nullptr, nullptr);
+        shortestPathTree(reverse, next, to, nullptr, nullptr);
+        addLandmark(next, from, to);
+    }
+}
+
+/**
+ * @brief 把新地标的正反向距离写入下一列
+ * 
+ * @param landmark 新地标
+ * @param from 地标到各顶点的距离
+ * @param to 各顶点到地标的距离
+ */
+void Landmarks::addLandmark(int landmark, const vector<int>& from, const vector<int>& to)
+{
+    int column = landmarks.size();
+    for(int v = 0; v < bound; v++)
+    {
+        fromTable[(size_t)v * k + column] = from[v];
+        toTable[(size_t)v * k + column] = to[v];
+    }
+    landmarks.push_back(landmark);
+}
+
+/**
+ * @brief farthest策略：选与已选地标最近距离最大的顶点
+ * 
+ * 第一个地标取离随机根最远的可达顶点。与所有地标都不连通的顶点视为无穷远，
+ * 因此其它连通分量会优先得到地标。
+ */
+template<class GraphT>
+int Landmarks::selectFarthest(const GraphT& graph, const vector<int>& vertices, mt19937& rng) const
+{
+    if(landmarks.empty())
+    {
+        int root = vertices[rng() % vertices.size()];
+        vector<int> dist;
+        shortestPathTree(graph, root, dist, nullptr, nullptr);
+        int chosen = root;
+        for(int v : vertices)
+            if(dist[v] != MAX && dist[v] > dist[chosen])
+                chosen = v;
+        return chosen;
+    }
+    int chosen = -1;
+    long long best = -1;
+    for(int v : vertices)
+    {
+        long long nearest = LLONG_MAX;
+        for(size_t i = 0; i < landmarks.size(); i++)
+        {
+            int d = fromTable[(size_t)v * k + i];
+            nearest = min(nearest, d == MAX ? LLONG_MAX : (long long)d);
+        }
+        if(nearest > best)
+        {
+            best = nearest;
+            chosen = v;
+        }
+    }
+    return chosen;
+}
+
+/**
+ * @brief avoid策略：在随机根的最短路树上找下界最差的分支，取该分支的叶子
+ * 
+ * 顶点权重为d(r,v)与当前地标给出的下界之差，子树大小为子树权重之和，
+ * 子树中已有地标则大小记为0。从大小最大的顶点出发，沿大小最大的孩子走到叶子。
+ * 
+ * @return 新地标，所有分支都已被覆盖时返回-1
+ */
+template<class GraphT>
+int Landmarks::selectAvoid(const GraphT& graph, const vector<int>& vertices, mt19937& rng) const
+{
+    int root = vertices[rng() % vertices.size()];
+    vector<int> dist, parent, order;
+    shortestPathTree(graph, root, dist, &parent, &order);
+
+    vector<long long> size(bound, 0);
+    vector<bool> covered(bound, false);
+    for(int landmark : landmarks)
+        covered[landmark] = true;
+    // 按确定顺序的逆序自底向上累加，孩子总是先于父节点处理
+    for(int i = order.size() - 1; i >= 0; i--)
+    {
+        int v = order[i];
+        if(covered[v])
+            size[v] = 0;
+        else
+            size[v] += dist[v] - potential(root, v);
+        if(parent[v] != -1)
+        {
+            if(covered[v])
+                covered[parent[v]] = true;
+            else
+                size[parent[v]] += size[v];
+        }
+    }
+
+    int chosen = -1;
+    for(int v : order)
+        if(size[v] > 0 && (chosen == -1 || size[v] > size[chosen]))
+            chosen = v;
+    if(chosen == -1)
+        return -1;
+
+    // 孩子表：按父节点分组
+    vector<int> first(bound + 1, 0), children(order.size());
+    for(int v : order)
+        if(parent[v] != -1)
+            first[parent[v] + 1]++;
+    for(int v = 0; v < bound; v++)
+        first[v + 1] += first[v];
+    vector<int> fill(first.begin(), first.end() - 1);
+    for(int v : order)
+        if(parent[v] != -1)
+            children[fill[parent[v]]++] = v;
+    while(first[chosen] != first[chosen + 1])
+    {
+        int next = children[first[chosen]];
+        for(int c = first[chosen] + 1; c < first[chosen + 1]; c++)
+            if(size[children[c]] > size[next])
+                next = children[c];
+        chosen = next;
+    }
+    return chosen;
+}
+
+/**
+ * @brief 由三角不等式得到的d(v,t)下界，作为A*的势函数
+ * 
+ * @param v 当前顶点
+ * @param t 目标顶点
+ * @return 下界，非负
+ */
+int Landmarks::potential(int v, int t) const
+{
+    int best = 0;
+    const int* fromV = &fromTable[(size_t)v * k];
+    const int* fromT = &fromTable[(size_t)t * k];
+    const int* toV = &toTable[(size_t)v * k];
+    const int* toT = &toTable[(size_t)t * k];
+    for(size_t i = 0; i < landmarks.size(); i++)
+    {
+        // d(v,t) >= d(v,L) - d(t,L)
+        if(toV[i] != MAX && toT[i] != MAX && toV[i] - toT[i] > best)
+            best = toV[i] - toT[i];
+        // d(v,t) >= d(L,t) - d(L,v)
+        if(fromT[i] != MAX && fromV[i] != MAX && fromT[i] - fromV[i] > best)
+            best = fromT[i] - fromV[i];
+    }
+    return best;
+}
+
+/**
+ * @brief 将地标和距离表写入二进制文件，可与图快照放在一起
+ * 
+ * @param filePath 文件路径
+ */
+void Landmarks::save(const string& filePath) const
+{
+    ofstream file(filePath, ios::binary | ios::trunc);
+    if(!file.is_open())
+        throw "Unable to create landmark file";
+    int32_t header[5] = {ALT_VERSION, k, bound, (int32_t)landmarks.size(), (int32_t)numbering};
+    file.write(ALT_MAGIC, sizeof(ALT_MAGIC));
+    file.write((const char*)header, sizeof(header));
+    file.write((const char*)landmarks.data(), sizeof(int) * landmarks.size());
+    file.write((const char*)fromTable.data(), sizeof(int) * fromTable.size());
+    file.write((const char*)toTable.data(), sizeof(int) * toTable.size());
+    if(!file.good())
+        throw "Failed writing landmark file";
+}
+
+/**
+ * @brief 读取save写出的地标文件
+ * 
+ * @param filePath 文件路径
+ * @return 加载结果
+ */
+const Landmarks& Landmarks::load(const string& filePath)
+{
+    ifstream file(filePath, ios::binary);
+    if(!file.is_open())
+        throw "Unable to open landmark file";
+    char magic[8];
+    int32_t header[5] = {0, 0, 0, 0, NAME_NUMBERING};
+    file.read(magic, sizeof(magic));
+    file.read((char*)header, sizeof(int32_t) * 4);
+    if(!file.good() || memcmp(magic, ALT_MAGIC, sizeof(ALT_MAGIC)) != 0)
+        throw "Not a landmark file";
+    if(header[0] != 1 && header[0] != ALT_VERSION)
+        throw "Unsupported landmark file version";
+    if(header[0] >= 2)
+        file.read((char*)&header[4], sizeof(int32_t));
+    if(!file.good() || header[1] <= 0 || header[2] < 0 || header[3] != header[1]
+       || (header[4] != NAME_NUMBERING && header[4] != COMPACT_NUMBERING))
+        throw "Corrupt landmark file";
+    k = header[1];
+    bound = header[2];
+    numbering = (LandmarkNumbering)header[4];
+    landmarks.resize(header[3]);
+    fromTable.resize((size_t)bound * k);
+    toTable.resize((size_t)bound * k);
+    file.read((char*)landmarks.data(), sizeof(int) * landmarks.size());
+    file.read((char*)fromTable.data(), sizeof(int) * fromTable.size());
+    file.read((char*)toTable.data(), sizeof(int) * toTable.size());
+    if(!file.good() || file.peek() != EOF)
+        throw "Corrupt landmark file";
+    return *this;
+}
@@ -1 +1,208 @@
-#include "Binary_Heap.h"
\ No newline at end of file
+#include "Binary_Heap.h"
+
+/**
+ * @brief 构造d叉堆
+ * 
+ * @param arity 叉数，只支持2、4、8
+ * @param capacity 顶点编号上界，用于预分配位置索引
+ */
+Binary_Heap::Binary_Heap(int arity, int capacity)
+{
+    if (arity == 2)
+        shift = 1;
+    else if (arity == 4)
+        shift = 2;
+    else if (arity == 8)
+        shift = 3;
+    else
+        throw "Unsupported heap arity";
+    heap.reserve(capacity);
+    pos.assign(capacity, -1);
+}
+
+Binary_Heap::~Binary_Heap()
+{
+}
+
+/**
+ * @brief 判断堆是否为空
+ * 
+ * @return 如果为空，则返回true；如果非空，则返回false
+ */
+bool Binary_Heap::isEmpty()
+{
+    return heap.empty();
+}
+
+/**
+ * @brief 获取堆中元素个数
+ * 
+ * @return 元素个数
+ */
+int Binary_Heap::size()
+{
+    return heap.size();
+}
+
+/**
+ * @brief 获取最小键值对应的顶点
+ * 
+ * @param pkey 用于存储最小键值对应顶点的指针
+ * @return 堆非空返回true，否则返回false
+ */
+bool Binary_Heap::minimum(int *pkey)
+{
+    if (heap.empty() || pkey == nullptr)
+        return false;
+    *pkey = heap[0].vertex;
+    return true;
+}
+
+/**
+ * @brief 把元素写入槽位并同步位置索引
+ * 
+ * @param slot 槽位
+ * @param entry 元素
+ */
+void Binary_Heap::place(int slot, const BHEntry& entry)
+{
+    heap[slot] = entry;
+    pos[entry.vertex] = slot;
+}
+
+/**
+ * @brief 从slot开始上滤，父节点下移而不是逐层交换
+ * 
+ * @param slot 起始槽位
+ * @param entry 要放置的元素
+ */
+void Binary_Heap::siftUp(int slot, BHEntry entry)
+{
+    while (slot > 0)
+    {
+        int parent = (slot - 1) >> shift;
+        if (heap[parent].key <= entry.key)
+            break;
+        place(slot, heap[parent]);
+        slot = parent;
+    }
+    place(slot, entry);
+}
+
+/**
+ * @brief 从slot开始下滤，每层在连续的d个孩子中找最小者
+ * 
+ * @param slot 起始槽位
+ * @param entry 要放置的元素
+ */
+void Binary_Heap::siftDown(int slot, BHEntry entry)
+{
+    int n = heap.size();
+    int arity = 1 << shift;
+    while (true)
+    {
+        int first = (slot << shift) + 1;
+        if (first >= n)
+            break;
+        int last = first + arity < n ? first + arity : n;
+        int least = first;
+        for (int c = first + 1; c < last; c++)
+            if (heap[c].key < heap[least].key)
+                least = c;
+        if (heap[least].key >= entry.key)
+            break;
+        place(slot, heap[least]);
+        slot = least;
+    }
+    place(slot, entry);
+}
+
+/**
+ * @brief 通过位置索引查找顶点所在槽位
+ * 
+ * @param vertex 顶点
+ * @return 槽位，不在堆中返回-1
+ */
+int Binary_Heap::search(int vertex)
+{
+    if (vertex < 0 || vertex >= (int)pos.size())
+        return -1;
+    return pos[vertex];
+}
+
+/**
+ * @brief 向堆中插入节点
+ * 
+ * @param key 节点键值
+ * @param vertex 节点名称
+ */
+void Binary_Heap::insert(int key, int vertex)
+{
+    if (contains(vertex))
+    {
+        throw "alreay exists";
+        return;
+    }
+    if (vertex >= (int)pos.size())
+        pos.resize(max(vertex + 1, (int)pos.size() * 2), -1);
+    heap.push_back(BHEntry(key, vertex));
+    siftUp(heap.size() - 1, heap.back());
+}
+
+/**
+ * @brief 移除最小值对应节点
+ * 
+ */
+void Binary_Heap::removeMin()
+{
+    if (heap.empty())
+        return;
+    pos[heap[0].vertex] = -1;
+    BHEntry last = heap.back();
+    heap.pop_back();
+    if (!heap.empty())
+        siftDown(0, last);
+}
+
+/**
+ * @brief 查询堆中是否包含顶点，O(1)
+ * 
+ * @param vertex 顶点名称
+ * @return 如果包含返回true，否则返回false
+ */
+bool Binary_Heap::contains(int vertex)
+{
+    return search(vertex) != -1;
+}
+
+/**
+ * @brief 更新节点值，顶点不在堆中时插入，O(log_d n)
+ * 
+ * @param vertex 要更新的节点的顶点名
+ * @param newkey 要更新节点的新键值
+ */
+void Binary_Heap::update(int vertex, int newkey)
+{
+    int slot = search(vertex);
+    if (slot == -1)
+    {
+        insert(newkey, vertex);
+        return;
+    }
+    BHEntry entry(newkey, vertex);
+    if (newkey < heap[slot].key)
+        siftUp(slot, entry);
+    else
+        siftDown(slot, entry);
+}
+
+/**
+ * @brief 清空堆，只重置仍在堆中的顶点的位置索引，O(堆大小)
+ * 
+ */
+void Binary_Heap::destroy()
+{
+    for (size_t i = 0; i < heap.size(); i++)
+        pos[heap[i].vertex] = -1;
+    heap.clear();
+}
@@ -1,4 +1,5 @@
 #include "Binomial_Queue.h"
+#include "Search_Stats.h"
 
 /**
  * @brief 判断二项队列是否为空
@@ -43,6 +44,7 @@ bool Binomial_Queue::minimum(int *pkey)
  */
 void Binomial_Queue::link(BiNode *child, BiNode *root)
 {
+    SEARCH_STAT(searchStats.link());
     child->parent = root;
     child->next = root->child;
     root->child = child;
@@ -177,19 +179,34 @@ BiNode *Binomial_Queue::removeMin(BiNode *root)
     //reverse拆成独立的二项堆是为了将度数递减变为递增
     BiNode* child = reverse(y->child);
     root = unionHeaps(root, child);
-    delete y;  
+    handles[y->vertex] = nullptr;
+    pool.release(y);
     return root;
 }
 
 /**
- * @brief 降低二项堆中某节点的键值。
+ * @brief 交换两个节点中的键值和顶点，并同步句柄索引。
+ * 
+ * @param a 第一个节点。
+ * @param b 第二个节点。
+ */
+void Binomial_Queue::exchange(BiNode *a, BiNode *b)
+{
+    swap(a->key, b->key);
+    swap(a->vertex, b->vertex);
+    handles[a->vertex] = a;
+    handles[b->vertex] = b;
+}
+
+/**
+ * @brief 降低二项堆中某节点的键值，沿父链上滤，O(log n)。
  * 
  * @param node 要降低键值的节点。
  * @param key 新的键值。
  */
 void Binomial_Queue::decreaseKey(BiNode *node, int key)
 {
-    if(key >= node->key || contains(key))
+    if(key >= node->key)
     {
         throw "decrease failed";
         return;
@@ -199,10 +216,8 @@ void Binomial_Queue::decreaseKey(BiNode *node, int key)
     BiNode* parent = node->parent;
     while (parent != nullptr && child->key < parent->key)
     {
-        // 交换parent和child的键值
-        int tmp = parent->key;
-        parent->key = child->key;
-        child->key = tmp;
+        // 交换parent和child的键值与顶点
+        exchange(parent, child);
         // 向上移动
         child = parent;
         parent = child->parent;
@@ -218,7 +233,7 @@ void Binomial_Queue::decreaseKey(BiNode *node, int key)
  */
 void Binomial_Queue::increaseKey(BiNode *node, int key)
 {
-    if(key <= node->key || contains(key))
+    if(key <= node->key)
     {
         throw "increase failed";
         return;
@@ -238,10 +253,8 @@ void Binomial_Queue::increaseKey(BiNode *node, int key)
                     least = child->next;
                 child = child->next;
             }
-            // 交换current节点和最小孩子节点的键值
-            int temp = least->key;
-            least->key = current->key;
-            current->key = temp;
+            // 交换current节点和最小孩子节点的键值与顶点
+            exchange(least, current);
             // 继续调整交换后的最小孩子节点，保持最小堆的性质
             current = least;
             child = current->child;
@@ -270,31 +283,32 @@ void Binomial_Queue::updateKey(BiNode *node, int key)
 }
 
 /**
- * @brief 在二项堆中搜索具有给定顶点的节点。
+ * @brief 通过句柄索引查找具有给定顶点的节点。
  * 
- * @param root 二项堆的根节点。
  * @param vertex 要搜索的顶点。
  * @return BiNode* 如果找到具有给定顶点的节点，则返回该节点；否则，返回 nullptr。
  */
-BiNode *Binomial_Queue::search(BiNode *root, int vertex)
+BiNode *Binomial_Queue::search(int vertex)
 {
-    if (root == nullptr)
+    if (vertex < 0 || vertex >= (int)handles.size())
         return nullptr;
-    BiNode* node = root;
-    while (node != nullptr)
-    {
-        if (node->vertex == vertex)
-            return node;
-        else
-        {
-            BiNode* found = search(node->child, vertex);
-            if(found != nullptr)
-                return found;
-            node = node->next;
-        }
-    }
+    BiNode* node = handles[vertex];
+    if (node == nullptr || node->epoch != epoch || node->vertex != vertex)
+        return nullptr;
+    return node;
+}
 
-    return nullptr;
+/**
+ * @brief 记录顶点对应的节点，索引不足时扩容。
+ * 
+ * @param vertex 顶点。
+ * @param node 节点指针。
+ */
+void Binomial_Queue::setHandle(int vertex, BiNode *node)
+{
+    if (vertex >= (int)handles.size())
+        handles.resize(max(vertex + 1, (int)handles.size() * 2), nullptr);
+    handles[vertex] = node;
 }
 
 /**
@@ -304,8 +318,19 @@ BiNode *Binomial_Queue::search(BiNode *root, int vertex)
  */
 void Binomial_Queue::combine(Binomial_Queue *other)
 {
-    if (other != nullptr && other->mRoot != nullptr)
-        mRoot = merge(mRoot, other->mRoot);
+    if (other == nullptr || other->mRoot == nullptr)
+        return;
+    // 两个队列统一到同一代数，失效句柄清空，之后节点和内存池一起并入this
+    unsigned next = max(epoch, other->epoch) + 1;
+    restamp(next);
+    other->restamp(next);
+    for (size_t i = 0; i < other->handles.size(); i++)
+        if (other->handles[i] != nullptr)
+            setHandle(i, other->handles[i]);
+    mRoot = unionHeaps(mRoot, other->mRoot);
+    pool.adopt(other->pool);
+    other->mRoot = nullptr;
+    other->handles.clear();
 }
 
 /**
@@ -316,12 +341,14 @@ void Binomial_Queue::combine(Binomial_Queue *other)
  */
 void Binomial_Queue::insert(int key, int vertex)
 {
-    if (contains(key))
+    if (contains(vertex))
     {
         throw "alreay exists";
         return;
     }
-    BiNode* node = new BiNode(key, vertex);
+    BiNode* node = pool.alloc(key, vertex);
+    node->epoch = epoch;
+    setHandle(vertex, node);
     mRoot = unionHeaps(mRoot, node);
 }
 
@@ -335,18 +362,18 @@ void Binomial_Queue::removeMin()
 }
 
 /**
- * @brief 在二项队列中查询是否包含顶点值为key的节点
+ * @brief 在二项队列中查询是否包含顶点为vertex的节点，O(1)
  * 
- * @param key 实际上是顶点名称
+ * @param vertex 顶点名称
  * @return 如果包含返回true，否则返回false
  */
-bool Binomial_Queue::contains(int key)
+bool Binomial_Queue::contains(int vertex)
 {
-    return search(mRoot, key) != nullptr ? true : false;
+    return search(vertex) != nullptr ? true : false;
 }
 
 /**
- * @brief 更新节点值
+ * @brief 更新节点值，顶点不在队列中时插入
  * 
  * @param vertex 要更新的节点的顶点名
  * @param newkey 要更新节点的新键值
@@ -354,7 +381,42 @@ bool Binomial_Queue::contains(int key)
 void Binomial_Queue::update(int vertex, int newkey)
 {
     BiNode* node;
-    node = search(mRoot, vertex);
+    node = search(vertex);
     if(node != nullptr)
         updateKey(node, newkey);
+    else
+        insert(newkey, vertex);
+}
+
+/**
+ * @brief 把仍有效的节点改记为新代数，失效句柄清空，O(句柄数)
+ * 
+ * @param next 新代数
+ */
+void Binomial_Queue::restamp(unsigned next)
+{
+    for (size_t i = 0; i < handles.size(); i++)
+    {
+        BiNode* node = search(i);
+        if (node != nullptr)
+            node->epoch = next;
+        else
+            handles[i] = nullptr;
+    }
+    epoch = next;
+}
+
+/**
+ * @brief 清空队列，O(1)：节点内存整体交还内存池，代数加1使所有旧句柄失效
+ * 
+ */
+void Binomial_Queue::destroy()
+{
+    pool.reset();
+    mRoot = nullptr;
+    if (++epoch == 0) // 代数回绕时才真正清空句柄
+    {
+        handles.assign(handles.size(), nullptr);
+        epoch = 1;
+    }
 }
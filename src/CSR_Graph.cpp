@@ -0,0 +1,194 @@
+#include "default.h"
+#include "CSR_Graph.h"
+#include "read_gr_txt.h"
+
+using namespace std;
+
+/**
+ * @brief 由边表构建CSR，原顶点名按升序重新编号为0..V-1
+ * 
+ * @param srcs 每条边的起点(原顶点名)
+ * @param dests 每条边的终点(原顶点名)
+ * @param weights 每条边的权值
+ */
+void CSRGraph::build(const vector<int>& srcs, const vector<int>& dests, const vector<int>& weights)
+{
+    int maxName = -1;
+    for(size_t i = 0; i < srcs.size(); i++)
+    {
+        if(srcs[i] < 0 || dests[i] < 0)
+            throw "Negative vertex name";
+        maxName = max(maxName, max(srcs[i], dests[i]));
+    }
+    // 标记出现过的顶点名，按升序分配新编号
+    ids.assign(maxName + 1, -1);
+    for(size_t i = 0; i < srcs.size(); i++)
+        ids[srcs[i]] = ids[dests[i]] = 0;
+    names.clear();
+    for(int name = 0; name <= maxName; name++)
+        if(ids[name] == 0)
+        {
+            ids[name] = names.size();
+            names.push_back(name);
+        }
+    V = names.size();
+    E = srcs.size();
+    // 计数排序：先统计出度，再前缀和得到偏移，最后按起点填充
+    offsets.assign(V + 1, 0);
+    for(int i = 0; i < E; i++)
+        offsets[ids[srcs[i]] + 1]++;
+    for(int u = 0; u < V; u++)
+        offsets[u + 1] += offsets[u];
+    arcs.assign(E, Edge());
+    vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for(int i = 0; i < E; i++)
+        arcs[fill[ids[srcs[i]]]++] = Edge(ids[dests[i]], weights[i]);
+    bindStorage();
+}
+
+/**
+ * @brief 让只读视图指向自有的vector存储，并释放可能持有的快照映射
+ */
+void CSRGraph::bindStorage()
+{
+    snapshot.reset();
+    offsetView = offsets.data();
+    arcView = arcs.data();
+    nameView = names.data();
+    idView = ids.data();
+    idCount = ids.size();
+}
+
+/**
+ * @brief 由邻接表形式的Graph构建CSR
+ * 
+ * @param graph 原图
+ * @return 构建完成的CSR图
+ */
+const CSRGraph& CSRGraph::buildFromGraph(const Graph& graph)
+{
+    vector<int> srcs, dests, weights;
+    srcs.reserve(graph.getE());
+    dests.reserve(graph.getE());
+    weights.reserve(graph.getE());
+    for(auto& entry : graph.adjList)
+        for(const Edge& edge : entry.second)
+        {
+            srcs.push_back(entry.first);
+            dests.push_back(edge.dest);
+            weights.push_back(edge.weight);
+        }
+    build(srcs, dests, weights);
+    return *this;
+}
+
+/**
+ * @brief 由"起点 终点 权值"格式的.txt文件构建CSR，无法解析的行被跳过
+ * 
+ * @param filePath 文件路径
+ * @return 构建完成的CSR图
+ */
+const CSRGraph& CSRGraph::buildFromtxt(const string& filePath)
+{
+    ifstream file(filePath);
+    string line;
+    if(!file.is_open())
+    {
+        throw "Unable to open .txt file, check your directory";
+        return *this;
+    }
+    vector<int> srcs, dests, weights;
+    while(getline(file, line))
+    {
+        istringstream iss(line);
+        int src, dest, weight;
+        if(!(iss >> src >> dest >> weight))
+            continue;
+        srcs.push_back(src);
+        dests.push_back(dest);
+        weights.push_back(weight);
+    }
+    build(srcs, dests, weights);
+    return *this;
+}
+
+/**
+ * @brief 直接从DIMACS .gr文件构建CSR，按头部给出的规模预分配
+ * 
+ * 顶点1..n编号为0..n-1。弧通常已按起点排序，此时一次扫描即可得到偏移；
+ * 否则再做一次计数排序。
+ * 
+ * @param filePath .gr文件路径
+ * @return 构建完成的CSR图
+ */
+const CSRGraph& CSRGraph::buildFromgr(const string& filePath)
+{
+    GrReader reader(filePath);
+    V = reader.getV();
+    E = reader.getE();
+    names.resize(V);
+    ids.assign(V + 1, -1);
+    for(int u = 0; u < V; u++)
+    {
+        names[u] = u + 1;
+        ids[u + 1] = u;
+    }
+    vector<int> srcs(E);
+    arcs.assign(E, Edge());
+    offsets.assign(V + 1, 0);
+    int src, dest, weight, count = 0;
+    bool sorted = true;
+    while(reader.next(src, dest, weight))
+    {
+        if(count >= E)
+            throw "More arcs than declared in .gr file";
+        if(src < 1 || src > V || dest < 1 || dest > V)
+            throw "Vertex out of range in .gr file";
+        if(count > 0 && src - 1 < srcs[count - 1])
+            sorted = false;
+        srcs[count] = src - 1;
+        arcs[count] = Edge(dest - 1, weight);
+        offsets[src]++;
+        count++;
+    }
+    if(count != E)
+        throw "Fewer arcs than declared in .gr file";
+    for(int u = 0; u < V; u++)
+        offsets[u + 1] += offsets[u];
+    if(!sorted)
+    {
+        vector<Edge> ordered(E);
+        vector<int> fill(offsets.begin(), offsets.end() - 1);
+        for(int i = 0; i < E; i++)
+            ordered[fill[srcs[i]]++] = arcs[i];
+        arcs.swap(ordered);
+    }
+    bindStorage();
+    return *this;
+}
+
+/**
+ * @brief 扫描全部边求最大边权，供Dial桶队列确定桶数
+ * 
+ * @return 最大边权，没有边时为0
+ */
+int CSRGraph::getMaxWeight() const
+{
+    int weight = 0;
+    for(int i = 0; i < E; i++)
+        weight = max(weight, arcView[i].weight);
+    return weight;
+}
+
+/**
+ * @brief 原顶点名转换为新编号
+ * 
+ * @param name 原顶点名
+ * @return 新编号，不存在返回-1
+ */
+int CSRGraph::index(const int& name) const
+{
+    if(name < 0 || name >= idCount)
+        return -1;
+    return idView[name];
+}
@@ -0,0 +1,199 @@
+#include "default.h"
+#include "CSR_Graph.h"
+#include "read_gr_txt.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+using namespace std;
+
+/*
+ * 二进制快照格式(本机字节序)：
+ *   SnapshotHeader(64字节)
+ *   offsets[V+1] | arcs[E] | names[V] | ids[idCount]
+ * 加载时整个文件只读映射，各数组直接指向映射内存。
+ */
+
+static_assert(is_trivially_copyable<Edge>::value, "Edge must be trivially copyable for snapshots");
+static_assert(sizeof(Edge) == 2 * sizeof(int), "Edge must be tightly packed for snapshots");
+
+static const char SNAPSHOT_MAGIC[8] = {'D', 'W', 'H', 'C', 'S', 'R', '\0', '\0'};
+static const uint32_t SNAPSHOT_VERSION = 1;
+static const uint64_t CHECKSUM_SEED = 0xcbf29ce484222325ULL;
+
+struct SnapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    int32_t V;
+    int32_t E;
+    int32_t idCount;
+    int32_t reserved;
+    uint64_t payloadSize;
+    uint64_t payloadChecksum;
+    uint64_t headerChecksum; // 覆盖本字段之前的所有字节
+    char padding[8];
+};
+
+static_assert(sizeof(SnapshotHeader) == 64, "SnapshotHeader layout changed");
+
+/**
+ * @brief 按8字节字做FNV-1a风格的校验和，可对多段数据链式调用
+ * 
+ * @param data 数据起点
+ * @param length 字节数
+ * @param hash 上一段的校验和(首段传CHECKSUM_SEED)
+ * @return 新的校验和
+ */
+static uint64_t checksum(const void* data, size_t length, uint64_t hash)
+{
+    const char* p = (const char*)data;
+    size_t i = 0;
+    for(; i + 8 <= length; i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        hash = (hash ^ word) * 0x100000001b3ULL;
+    }
+    for(; i < length; i++)
+        hash = (hash ^ (unsigned char)p[i]) * 0x100000001b3ULL;
+    return hash;
+}
+
+/**
+ * @brief 计算各数组段的校验和，顺序与文件中一致
+ */
+static uint64_t payloadChecksum(const int* offsets, const Edge* arcs, const int* names, const int* ids,
+                                int V, int E, int idCount)
+{
+    uint64_t hash = CHECKSUM_SEED;
+    hash = checksum(offsets, sizeof(int) * (size_t)(V + 1), hash);
+    hash = checksum(arcs, sizeof(Edge) * (size_t)E, hash);
+    hash = checksum(names, sizeof(int) * (size_t)V, hash);
+    hash = checksum(ids, sizeof(int) * (size_t)idCount, hash);
+    return hash;
+}
+
+/**
+ * @brief 各数组段的总字节数
+ */
+static uint64_t payloadSize(int V, int E, int idCount)
+{
+    return sizeof(int) * (uint64_t)(V + 1) + sizeof(Edge) * (uint64_t)E
+         + sizeof(int) * (uint64_t)V + sizeof(int) * (uint64_t)idCount;
+}
+
+/**
+ * @brief 检查数组结构：偏移从0单调不减到E，弧终点和ids中的编号都在[0,V)内(ids允许-1)
+ * 
+ * 不依赖校验和，损坏但大小正确的文件也不会让edges()、index()越界。需要扫描全部数组，
+ * 只在verify时进行。
+ */
+static void validateStructure(const int* offsets, const Edge* arcs, const int* ids, int V, int E, int idCount)
+{
+    if(offsets[0] != 0 || offsets[V] != E)
+        throw "Corrupt snapshot offsets";
+    for(int u = 0; u < V; u++)
+        if(offsets[u] > offsets[u + 1])
+            throw "Corrupt snapshot offsets";
+    for(int i = 0; i < E; i++)
+        if(arcs[i].dest < 0 || arcs[i].dest >= V || arcs[i].weight < 0)
+            throw "Corrupt snapshot arcs";
+    for(int i = 0; i < idCount; i++)
+        if(ids[i] < -1 || ids[i] >= V)
+            throw "Corrupt snapshot ids";
+}
+
+/**
+ * @brief 将CSR图写成二进制快照，之后可用loadSnapshot零解析加载
+ * 
+ * @param filePath 快照文件路径
+ */
+void CSRGraph::saveSnapshot(const string& filePath) const
+{
+    if(offsetView == nullptr)
+        throw "Saving an empty graph";
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+    header.V = V;
+    header.E = E;
+    header.idCount = idCount;
+    header.payloadSize = payloadSize(V, E, idCount);
+    header.payloadChecksum = payloadChecksum(offsetView, arcView, nameView, idView, V, E, idCount);
+    header.headerChecksum = checksum(&header, offsetof(SnapshotHeader, headerChecksum), CHECKSUM_SEED);
+
+    ofstream file(filePath, ios::binary | ios::trunc);
+    if(!file.is_open())
+        throw "Unable to create snapshot file";
+    file.write((const char*)&header, sizeof(header));
+    file.write((const char*)offsetView, sizeof(int) * (size_t)(V + 1));
+    file.write((const char*)arcView, sizeof(Edge) * (size_t)E);
+    file.write((const char*)nameView, sizeof(int) * (size_t)V);
+    file.write((const char*)idView, sizeof(int) * (size_t)idCount);
+    if(!file.good())
+        throw "Failed writing snapshot file";
+}
+
+/**
+ * @brief 只读映射二进制快照，CSR数组直接指向映射内存
+ * 
+ * 头部和文件大小总是校验。verify为true时检查数组结构并核对整个数据段的校验和，
+ * 需要完整读一遍文件；为false时信任文件内容，不触碰数据段，加载只需毫秒级，
+ * 只应用于saveSnapshot写出且未被改动的文件，损坏的数组会让查询越界。
+ * 
+ * @param filePath 快照文件路径
+ * @param verify 是否检查数组结构和数据段校验和
+ * @return 加载完成的CSR图
+ */
+const CSRGraph& CSRGraph::loadSnapshot(const string& filePath, bool verify)
+{
+    shared_ptr<MappedFile> file = make_shared<MappedFile>(filePath, false);
+    if(file->size() < sizeof(SnapshotHeader))
+        throw "Snapshot file truncated";
+    SnapshotHeader header;
+    memcpy(&header, file->begin(), sizeof(header));
+    if(memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0)
+        throw "Not a graph snapshot";
+    if(header.version != SNAPSHOT_VERSION || header.headerSize != sizeof(SnapshotHeader))
+        throw "Unsupported snapshot version";
+    if(header.headerChecksum != checksum(&header, offsetof(SnapshotHeader, headerChecksum), CHECKSUM_SEED))
+        throw "Corrupt snapshot header";
+    if(header.V < 0 || header.E < 0 || header.idCount < 0
+       || header.payloadSize != payloadSize(header.V, header.E, header.idCount)
+       || file->size() != sizeof(SnapshotHeader) + header.payloadSize)
+        throw "Snapshot file size mismatch";
+
+    const char* p = file->begin() + sizeof(SnapshotHeader);
+    const int* offsetData = (const int*)p;
+    p += sizeof(int) * (size_t)(header.V + 1);
+    const Edge* arcData = (const Edge*)p;
+    p += sizeof(Edge) * (size_t)header.E;
+    const int* nameData = (const int*)p;
+    p += sizeof(int) * (size_t)header.V;
+    const int* idData = (const int*)p;
+
+    if(verify)
+        validateStructure(offsetData, arcData, idData, header.V, header.E, header.idCount);
+    if(verify && header.payloadChecksum != payloadChecksum(offsetData, arcData, nameData, idData,
+                                                          header.V, header.E, header.idCount))
+        throw "Snapshot checksum mismatch";
+
+    offsets.clear();
+    arcs.clear();
+    names.clear();
+    ids.clear();
+    V = header.V;
+    E = header.E;
+    offsetView = offsetData;
+    arcView = arcData;
+    nameView = nameData;
+    idView = idData;
+    idCount = header.idCount;
+    snapshot = file;
+    return *this;
+}
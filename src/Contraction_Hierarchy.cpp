@@ -0,0 +1,394 @@
+#include "default.h"
+#include "Contraction_Hierarchy.h"
+#include "CSR_Graph.h"
+#include <thread>
+
+using namespace std;
+
+// 见证搜索最多确定的顶点数，超过则认为没有见证路径(多加捷径不影响正确性)
+static const int WITNESS_SETTLE_LIMIT = 500;
+
+/**
+ * @class WitnessSpace
+ * @brief 见证搜索用的堆、距离标签和目标标记，每个线程一份
+ */
+class WitnessSpace
+{
+public:
+    Binary_Heap queue;
+    DijkstraWorkspace labels;
+    vector<unsigned> mark; // mark[w]==round表示w是本轮尚未确定的目标
+    unsigned round;
+
+    WitnessSpace(int V):queue(4, V), mark(V, 0), round(0){};
+};
+
+/**
+ * @class Contractor
+ * @brief 预处理期间的动态图，只保存尚未收缩的顶点之间的边
+ */
+class Contractor
+{
+public:
+    int V;
+    vector<vector<Edge>> out; // 出边
+    vector<vector<Edge>> in; // 入边，dest存的是起点
+    vector<int> deleted; // 已收缩的邻居数
+    vector<vector<Edge>> upLists; // 收缩时留下的向上出边
+    vector<vector<Edge>> downLists; // 收缩时留下的向上入边
+    int shortcutCount;
+
+    Contractor(const CSRGraph& graph);
+    void addArc(int u, int w, int weight);
+    void witness(int source, int skip, int limit, int targets, WitnessSpace& space) const;
+    int shortcuts(int v, WitnessSpace& space, vector<pair<int, Edge>>* added) const;
+    int priority(int v, WitnessSpace& space) const;
+    void contract(int v, WitnessSpace& space);
+};
+
+/**
+ * @brief 由CSR初始化动态图，去掉自环，平行边只保留最短的一条
+ */
+Contractor::Contractor(const CSRGraph& graph)
+    : V(graph.getV()), out(V), in(V), deleted(V, 0), upLists(V), downLists(V), shortcutCount(0)
+{
+    for(int u = 0; u < V; u++)
+        for(const Edge& edge : graph.edges(u))
+            if(edge.dest != u)
+                addArc(u, edge.dest, edge.weight);
+}
+
+/**
+ * @brief 加入边u->w，已有该边时保留较小的权值
+ */
+void Contractor::addArc(int u, int w, int weight)
+{
+    for(Edge& edge : out[u])
+        if(edge.dest == w)
+        {
+            if(weight < edge.weight)
+            {
+                edge.weight = weight;
+                for(Edge& back : in[w])
+                    if(back.dest == u)
+                        back.weight = weight;
+            }
+            return;
+        }
+    out[u].push_back(Edge(w, weight));
+    in[w].push_back(Edge(u, weight));
+}
+
+/**
+ * @brief 从source出发、绕开skip的有界Dijkstra，结果留在space.labels中
+ * 
+ * 距离超过limit、确定的顶点数超过上限或所有目标都已确定时停止。
+ * 
+ * @param source 起点
+ * @param skip 正在收缩的顶点
+ * @param limit 距离上界
+ * @param targets 已在space.mark中标记的目标个数
+ * @param space 搜索空间
+ */
+void Contractor::witness(int source, int skip, int limit, int targets, WitnessSpace& space) const
+{
+    Binary_Heap& queue = space.queue;
+    DijkstraWorkspace& labels = space.labels;
+    labels.prepare(V);
+    labels.reach(source, 0);
+    queue.insert(0, source);
+    int settledCount = 0;
+    while(!queue.isEmpty())
+    {
+        int u = 0;
+        queue.minimum(&u);
+        queue.removeMin();
+        labels.settle(u);
+        int du = labels.distance(u);
+        if(du > limit || ++settledCount > WITNESS_SETTLE_LIMIT)
+            break;
+        if(space.mark[u] == space.round && --targets == 0)
+            break;
+        for(const Edge& edge : out[u])
+        {
+            int w = edge.dest;
+            if(w == skip || labels.settled(w))
+                continue;
+            if(du + edge.weight < labels.distance(w))
+            {
+                labels.reach(w, du + edge.weight);
+                queue.update(w, du + edge.weight);
+            }
+        }
+    }
+    if(!queue.isEmpty())
+        queue.destroy();
+}
+
+/**
+ * @brief 统计收缩v需要的捷径，added非空时同时记录这些捷径
+ * 
+ * 对每个入邻居u做一次见证搜索，若u->v->w不比见证路径更短则无需捷径。
+ * 
+ * @return 捷径条数
+ */
+int Contractor::shortcuts(int v, WitnessSpace& space, vector<pair<int, Edge>>* added) const
+{
+    int count = 0;
+    for(const Edge& inEdge : in[v])
+    {
+        int u = inEdge.dest;
+        int limit = 0, targets = 0;
+        space.round++;
+        for(const Edge& outEdge : out[v])
+            if(outEdge.dest != u)
+            {
+                limit = max(limit, inEdge.weight + outEdge.weight);
+                space.mark[outEdge.dest] = space.round;
+                targets++;
+            }
+        if(targets == 0)
+            continue;
+        witness(u, v, limit, targets, space);
+        for(const Edge& outEdge : out[v])
+        {
+            int w = outEdge.dest;
+            int via = inEdge.weight + outEdge.weight;
+            if(w == u || space.labels.distance(w) <= via)
+                continue;
+            count++;
+            if(added != nullptr)
+                added->push_back(make_pair(u, Edge(w, via)));
+        }
+    }
+    return count;
+}
+
+/**
+ * @brief 收缩优先级：边差(新增捷径数-删除的边数)加上已收缩邻居数，越小越先收缩
+ * 
+ * 已收缩邻居数让收缩在图上分布得更均匀。
+ */
+int Contractor::priority(int v, WitnessSpace& space) const
+{
+    return shortcuts(v, space, nullptr) - (int)(in[v].size() + out[v].size()) + deleted[v];
+}
+
+/**
+ * @brief 收缩v：保留它到未收缩邻居的边作为层次中的向上边，删除v并加入捷径
+ */
+void Contractor::contract(int v, WitnessSpace& space)
+{
+    vector<pair<int, Edge>> added;
+    shortcuts(v, space, &added);
+    upLists[v] = out[v];
+    downLists[v] = in[v];
+    for(const Edge& edge : out[v])
+    {
+        vector<Edge>& list = in[edge.dest];
+        for(size_t i = 0; i < list.size(); i++)
+            if(list[i].dest == v)
+            {
+                list[i] = list.back();
+                list.pop_back();
+                break;
+            }
+        deleted[edge.dest]++;
+    }
+    for(const Edge& edge : in[v])
+    {
+        vector<Edge>& list = out[edge.dest];
+        for(size_t i = 0; i < list.size(); i++)
+            if(list[i].dest == v)
+            {
+                list[i] = list.back();
+                list.pop_back();
+                break;
+            }
+        deleted[edge.dest]++;
+    }
+    out[v].clear();
+    out[v].shrink_to_fit();
+    in[v].clear();
+    in[v].shrink_to_fit();
+    for(auto& shortcut : added)
+        addArc(shortcut.first, shortcut.second.dest, shortcut.second.weight);
+    shortcutCount += added.size();
+}
+
+/**
+ * @brief 把每个顶点的边表压成CSR
+ */
+static void pack(const vector<vector<Edge>>& lists, vector<int>& offsets, vector<Edge>& arcs)
+{
+    int V = lists.size();
+    offsets.assign(V + 1, 0);
+    for(int u = 0; u < V; u++)
+        offsets[u + 1] = offsets[u] + lists[u].size();
+    arcs.clear();
+    arcs.reserve(offsets[V]);
+    for(int u = 0; u < V; u++)
+        arcs.insert(arcs.end(), lists[u].begin(), lists[u].end());
+}
+
+/**
+ * @brief 预处理：计算收缩顺序并加入捷径，生成upward/downward搜索图
+ * 
+ * 初始优先级互不依赖，按顶点区间分给多个线程并行计算，每个线程有自己的堆和
+ * 工作区；之后按惰性更新逐个收缩：取出优先级最小的顶点时重新计算，若已不再
+ * 最小则放回，否则收缩它并刷新邻居的优先级。
+ * 
+ * @param graph 原图
+ * @param threads 计算初始优先级的线程数，0表示使用硬件线程数
+ * @return 预处理结果
+ */
+const ContractionHierarchy& ContractionHierarchy::build(const Graph& graph, int threads)
+{
+    CSRGraph csr;
+    csr.buildFromGraph(graph);
+    V = csr.getV();
+    ids.assign(graph.getBound(), -1);
+    for(int name = 0; name < graph.getBound(); name++)
+        ids[name] = csr.index(name);
+
+    Contractor contractor(csr);
+    vector<int> priorities(V);
+    if(threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    threads = max(1, min(threads, V));
+    vector<thread> workers;
+    for(int id = 0; id < threads; id++)
+        workers.emplace_back([&, id]{
+            WitnessSpace space(V);
+            for(int v = id; v < V; v += threads)
+                priorities[v] = contractor.priority(v, space);
+        });
+    for(thread& worker : workers)
+        worker.join();
+
+    Binary_Heap order(4, V);
+    for(int v = 0; v < V; v++)
+        order.insert(priorities[v], v);
+    WitnessSpace space(V);
+    rank.assign(V, -1);
+    int next = 0;
+    while(!order.isEmpty())
+    {
+        int v = 0;
+        order.minimum(&v);
+        order.removeMin();
+        // 惰性更新：重新计算后若不再是最小，放回堆中
+        priorities[v] = contractor.priority(v, space);
+        int head = 0;
+        if(order.minimum(&head) && priorities[v] > priorities[head])
+        {
+            order.insert(priorities[v], v);
+            continue;
+        }
+        vector<int> neighbors;
+        for(const Edge& edge : contractor.out[v])
+            neighbors.push_back(edge.dest);
+        for(const Edge& edge : contractor.in[v])
+            neighbors.push_back(edge.dest);
+        contractor.contract(v, space);
+        rank[v] = next++;
+        for(int u : neighbors)
+            if(rank[u] == -1)
+            {
+                priorities[u] = contractor.priority(u, space);
+                order.update(u, priorities[u]);
+            }
+    }
+    shortcutCount = contractor.shortcutCount;
+    pack(contractor.upLists, upOffsets, upArcs);
+    pack(contractor.downLists, downOffsets, downArcs);
+    return *this;
+}
+
+/**
+ * @brief 原顶点名转换为内部编号
+ * 
+ * @param name 原顶点名
+ * @return 编号，不存在返回-1
+ */
+int ContractionHierarchy::index(const int& name) const
+{
+    if(name < 0 || name >= (int)ids.size())
+        return -1;
+    return ids[name];
+}
+
+/**
+ * @brief 单侧向上扩展一步，顺带用另一侧的标签更新mu
+ */
+static void expand(const ContractionHierarchy& ch, bool forward, Binary_Heap& queue, DijkstraWorkspace& space,
+                   const DijkstraWorkspace& other, long long& mu)
+{
+    int u = 0;
+    queue.minimum(&u);
+    queue.removeMin();
+    space.settle(u);
+    int du = space.distance(u);
+    int back = other.distance(u);
+    if(back != MAX && (long long)du + back < mu)
+        mu = (long long)du + back;
+    for(const Edge& edge : forward ? ch.upward(u) : ch.downward(u))
+    {
+        int v = edge.dest;
+        if(!space.settled(v) && du + edge.weight < space.distance(v))
+        {
+            space.reach(v, du + edge.weight);
+            queue.update(v, du + edge.weight);
+        }
+    }
+}
+
+/**
+ * @brief 双向向上搜索，两侧交替；某侧堆顶不小于mu时该侧停止
+ * 
+ * @param src 起点(原顶点名)
+ * @param dest 终点(原顶点名)
+ * @return 最短距离，不可达时抛出异常
+ */
+const int ContractionHierarchy::query(const int& src, const int& dest, Binary_Heap& forward, Binary_Heap& backward,
+                                      DijkstraWorkspace& forwardSpace, DijkstraWorkspace& backwardSpace) const
+{
+    int s = index(src), t = index(dest);
+    if(s == -1 || t == -1)
+        throw "Source not found";
+    forwardSpace.prepare(V);
+    backwardSpace.prepare(V);
+    forwardSpace.reach(s, 0);
+    backwardSpace.reach(t, 0);
+    forward.insert(0, s);
+    backward.insert(0, t);
+    long long mu = MAX;
+    bool turn = true;
+    while(true)
+    {
+        int u = 0;
+        bool forwardOpen = forward.minimum(&u) && forwardSpace.distance(u) < mu;
+        bool backwardOpen = backward.minimum(&u) && backwardSpace.distance(u) < mu;
+        if(!forwardOpen && !backwardOpen)
+            break;
+        if(forwardOpen && (turn || !backwardOpen))
+            expand(*this, true, forward, forwardSpace, backwardSpace, mu);
+        else
+            expand(*this, false, backward, backwardSpace, forwardSpace, mu);
+        turn = !turn;
+    }
+    if(!forward.isEmpty())
+        forward.destroy();
+    if(!backward.isEmpty())
+        backward.destroy();
+    if(mu >= MAX)
+        throw "Path Not Found";
+    return (int)mu;
+}
+
+const int ContractionHierarchy::query(const int& src, const int& dest) const
+{
+    Binary_Heap forward(4, V), backward(4, V);
+    DijkstraWorkspace forwardSpace, backwardSpace;
+    return query(src, dest, forward, backward, forwardSpace, backwardSpace);
+}
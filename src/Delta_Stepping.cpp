@@ -0,0 +1,203 @@
+#include "default.h"
+#include "Delta_Stepping.h"
+#include <thread>
+#include <barrier>
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief 每次从共享前沿领取的顶点数，太小时领取的原子操作成为瓶颈
+ */
+static const size_t CHUNK = 64;
+
+/**
+ * @brief 准备重排后的出边和每个线程的桶缓冲
+ *
+ * @param graph 只读共享的图，生命周期需长于本对象
+ * @param delta 桶宽，0表示取平均边权
+ * @param threads 线程数，0表示使用硬件线程数
+ */
+DeltaStepping::DeltaStepping(const CSRGraph& graph, int delta, int threads)
+    : graph(graph), delta(0), threads(threads), binCount(0), dist(new atomic<int>[graph.getV()])
+{
+    if(this->threads <= 0)
+        this->threads = max(1u, thread::hardware_concurrency());
+    states.resize(this->threads);
+    setDelta(delta);
+}
+
+/**
+ * @brief 修改桶宽并按新的轻重划分重排出边
+ *
+ * 桶宽越小越接近Dijkstra，重复松弛少但桶多、每桶可并行的顶点少；越大则相反。
+ *
+ * @param delta 桶宽，0表示取平均边权
+ */
+void DeltaStepping::setDelta(int delta)
+{
+    if(delta <= 0)
+    {
+        long long sum = 0;
+        for(int u = 0; u < graph.getV(); u++)
+            for(const Edge& edge : graph.edges(u))
+                sum += edge.weight;
+        delta = graph.getE() > 0 ? max(1LL, sum / graph.getE()) : 1;
+    }
+    this->delta = delta;
+    split();
+}
+
+/**
+ * @brief 复制出边，每个顶点的轻边排在重边之前
+ */
+void DeltaStepping::split()
+{
+    int V = graph.getV();
+    offsets.assign(V + 1, 0);
+    lightEnd.assign(V, 0);
+    arcs.resize(graph.getE());
+    int pos = 0;
+    for(int u = 0; u < V; u++)
+    {
+        offsets[u] = pos;
+        for(const Edge& edge : graph.edges(u))
+            if(edge.weight < delta)
+                arcs[pos++] = edge;
+        lightEnd[u] = pos;
+        for(const Edge& edge : graph.edges(u))
+            if(edge.weight >= delta)
+                arcs[pos++] = edge;
+    }
+    offsets[V] = pos;
+    // 待处理的距离落在[当前桶下界, 当前桶上界+最大边权)内，跨越的桶数有上限，桶缓冲可以循环使用
+    binCount = graph.getMaxWeight() / delta + 2;
+    for(ThreadState& state : states)
+        state.bins.assign(binCount, vector<Pending>());
+}
+
+/**
+ * @brief 用CAS把v的距离降为d，成功时把v放入线程自己的桶缓冲
+ */
+void DeltaStepping::relax(ThreadState& state, int v, int d)
+{
+    int old = dist[v].load(memory_order_relaxed);
+    while(d < old)
+    {
+        if(dist[v].compare_exchange_weak(old, d, memory_order_relaxed))
+        {
+            state.bins[(d / delta) % binCount].push_back(Pending{v, d});
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 一对全部查询
+ *
+ * @param src 起点(原顶点名)
+ * @return 以CSR编号为下标的距离数组，不可达为MAX，与dijkstraAll的结果相同
+ */
+vector<int> DeltaStepping::run(const int& src)
+{
+    int s = graph.index(src);
+    if(s == -1)
+        throw "Source not found";
+    int V = graph.getV();
+    for(int v = 0; v < V; v++)
+        dist[v].store(MAX, memory_order_relaxed);
+    for(ThreadState& state : states)
+    {
+        for(vector<Pending>& bin : state.bins)
+            bin.clear();
+        state.settled.clear();
+    }
+    dist[s].store(0, memory_order_relaxed);
+
+    vector<Pending> frontier(1, Pending{s, 0}); // 当前桶中待处理的顶点，各线程共享
+    atomic<size_t> cursor(0);
+    int current = 0; // 当前桶号
+    bool finished = false;
+    barrier sync(threads);
+
+    // 把各线程缓冲中桶号为bucket的顶点汇总到前沿，只由0号线程在两道屏障之间调用
+    auto gather = [&](int bucket){
+        frontier.clear();
+        for(ThreadState& state : states)
+        {
+            vector<Pending>& bin = state.bins[bucket % binCount];
+            frontier.insert(frontier.end(), bin.begin(), bin.end());
+            bin.clear();
+        }
+        cursor.store(0, memory_order_relaxed);
+    };
+
+    auto work = [&](int id){
+        ThreadState& state = states[id];
+        while(true)
+        {
+            // 轻边阶段：松弛可能把顶点放回当前桶，反复进行直到当前桶为空
+            while(true)
+            {
+                size_t begin;
+                while((begin = cursor.fetch_add(CHUNK, memory_order_relaxed)) < frontier.size())
+                {
+                    size_t end = min(frontier.size(), begin + CHUNK);
+                    for(size_t i = begin; i < end; i++)
+                    {
+                        int u = frontier[i].v, du = frontier[i].dist;
+                        if(dist[u].load(memory_order_relaxed) != du)
+                            continue;
+                        state.settled.push_back(u);
+                        for(int k = offsets[u]; k < lightEnd[u]; k++)
+                            relax(state, arcs[k].dest, du + arcs[k].weight);
+                    }
+                }
+                sync.arrive_and_wait();
+                if(id == 0)
+                    gather(current);
+                sync.arrive_and_wait();
+                if(frontier.empty())
+                    break;
+            }
+            // 重边阶段：本桶的距离已确定，重边只会落到后面的桶，每个顶点松弛一次即可
+            for(int u : state.settled)
+            {
+                int du = dist[u].load(memory_order_relaxed);
+                for(int k = lightEnd[u]; k < offsets[u + 1]; k++)
+                    relax(state, arcs[k].dest, du + arcs[k].weight);
+            }
+            state.settled.clear();
+            sync.arrive_and_wait();
+            if(id == 0)
+            {
+                finished = true;
+                for(int k = 1; k < binCount && finished; k++)
+                    for(ThreadState& other : states)
+                        if(!other.bins[(current + k) % binCount].empty())
+                        {
+                            current += k;
+                            finished = false;
+                            break;
+                        }
+                if(!finished)
+                    gather(current);
+            }
+            sync.arrive_and_wait();
+            if(finished)
+                return;
+        }
+    };
+
+    vector<thread> workers;
+    for(int id = 1; id < threads; id++)
+        workers.emplace_back(work, id);
+    work(0);
+    for(thread& worker : workers)
+        worker.join();
+
+    vector<int> result(V);
+    for(int v = 0; v < V; v++)
+        result[v] = dist[v].load(memory_order_relaxed);
+    return result;
+}
@@ -0,0 +1,192 @@
+#include "Dial_Queue.h"
+
+/**
+ * @brief 构造桶队列
+ * 
+ * @param maxWeight 图中最大边权，决定桶数
+ * @param capacity 顶点编号上界，用于预分配链表数组
+ */
+Dial_Queue::Dial_Queue(int maxWeight, int capacity):cursor(0), count(0)
+{
+    if(maxWeight < 0)
+        throw "Negative edge weight";
+    width = maxWeight + 1;
+    heads.assign(width, -1);
+    next.assign(capacity, -1);
+    prev.assign(capacity, -1);
+    keys.assign(capacity, -1);
+}
+
+Dial_Queue::~Dial_Queue()
+{
+}
+
+/**
+ * @brief 判断队列是否为空
+ * 
+ * @return 如果为空，则返回true；如果非空，则返回false
+ */
+bool Dial_Queue::isEmpty()
+{
+    return count == 0;
+}
+
+/**
+ * @brief 获取队列中元素个数
+ * 
+ * @return 元素个数
+ */
+int Dial_Queue::size()
+{
+    return count;
+}
+
+/**
+ * @brief 顶点编号超出预分配范围时扩充数组
+ * 
+ * @param vertex 顶点
+ */
+void Dial_Queue::grow(int vertex)
+{
+    if(vertex >= (int)keys.size())
+    {
+        next.resize(vertex + 1, -1);
+        prev.resize(vertex + 1, -1);
+        keys.resize(vertex + 1, -1);
+    }
+}
+
+/**
+ * @brief 把顶点挂到键值所在桶的表头
+ */
+void Dial_Queue::link(int key, int vertex)
+{
+    if(key < cursor || key - cursor >= width)
+        throw "key out of bucket range";
+    int b = key % width;
+    keys[vertex] = key;
+    prev[vertex] = -1;
+    next[vertex] = heads[b];
+    if(heads[b] != -1)
+        prev[heads[b]] = vertex;
+    heads[b] = vertex;
+}
+
+/**
+ * @brief 把顶点从所在桶的链表中摘下
+ */
+void Dial_Queue::unlink(int vertex)
+{
+    if(prev[vertex] != -1)
+        next[prev[vertex]] = next[vertex];
+    else
+        heads[keys[vertex] % width] = next[vertex];
+    if(next[vertex] != -1)
+        prev[next[vertex]] = prev[vertex];
+    keys[vertex] = -1;
+}
+
+/**
+ * @brief 把cursor推进到第一个非空桶，调用前队列须非空
+ */
+void Dial_Queue::advance()
+{
+    while(heads[cursor % width] == -1)
+        cursor++;
+}
+
+/**
+ * @brief 获取最小键值对应的顶点
+ * 
+ * @param pkey 用于存储最小键值对应顶点的指针
+ * @return 队列非空返回true，否则返回false
+ */
+bool Dial_Queue::minimum(int *pkey)
+{
+    if(count == 0 || pkey == nullptr)
+        return false;
+    advance();
+    *pkey = heads[cursor % width];
+    return true;
+}
+
+/**
+ * @brief 插入键值
+ * 
+ * @param key 键值，须落在[cursor, cursor+最大边权]内；队列为空且key在窗口外时cursor移到key
+ * @param vertex 顶点
+ */
+void Dial_Queue::insert(int key, int vertex)
+{
+    grow(vertex);
+    if(keys[vertex] != -1)
+        throw "alreay exists";
+    if(count == 0 && (key < cursor || key - cursor >= width))
+        cursor = key;
+    link(key, vertex);
+    count++;
+}
+
+/**
+ * @brief 移除最小键值
+ */
+void Dial_Queue::removeMin()
+{
+    if(count == 0)
+        return;
+    advance();
+    unlink(heads[cursor % width]);
+    count--;
+}
+
+/**
+ * @brief 判断顶点是否在队列中
+ * 
+ * @param vertex 顶点
+ * @return 在队列中返回true，否则返回false
+ */
+bool Dial_Queue::contains(int vertex)
+{
+    return vertex >= 0 && vertex < (int)keys.size() && keys[vertex] != -1;
+}
+
+/**
+ * @brief 修改顶点的键值，顶点不在队列中时插入
+ * 
+ * @param vertex 顶点
+ * @param newkey 新键值
+ */
+void Dial_Queue::update(int vertex, int newkey)
+{
+    if(!contains(vertex))
+    {
+        insert(newkey, vertex);
+        return;
+    }
+    int old = keys[vertex];
+    unlink(vertex);
+    try{
+        link(newkey, vertex);
+    }catch(const char*){
+        link(old, vertex);
+        throw;
+    }
+}
+
+/**
+ * @brief 清空队列，只遍历非空桶的链表
+ */
+void Dial_Queue::destroy()
+{
+    for(int b = 0; b < width && count > 0; b++)
+    {
+        for(int v = heads[b]; v != -1; v = next[v])
+        {
+            keys[v] = -1;
+            count--;
+        }
+        heads[b] = -1;
+    }
+    count = 0;
+    cursor = 0;
+}
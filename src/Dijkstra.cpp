@@ -1,6 +1,10 @@
 #include "default.h"
 #include "Dijkstra.h"
 #include "Binomial_Queue.h"
+#include "CSR_Graph.h"
+#include "read_gr_txt.h"
+#include <climits>
+#include <algorithm>
 
 using namespace std;
 
@@ -12,6 +16,7 @@ bool Graph::addVertex(const int& name)
         return false;
     }
     adjList[name] = vector<Edge>();
+    maxVertex = max(maxVertex, name);
     V++;
     return true;
 }
@@ -26,6 +31,7 @@ bool Graph::addEdge(const int& name, Edge& newedge)
     if(adjList.find(name) == adjList.end())
         adjList[name] = vector<Edge>();
     adjList[name].push_back(newedge);
+    maxVertex = max(maxVertex, max(name, newedge.dest));
     V++;
     E++;
     return true;
@@ -41,6 +47,7 @@ bool Graph::addEdge(const int& name, const int& dest, const int& weight)
     if(adjList.find(name) == adjList.end())
         adjList[name] = vector<Edge>();
     adjList[name].push_back(Edge(dest, weight));
+    maxVertex = max(maxVertex, max(name, dest));
     V++;
     E++;
     return true;
@@ -97,6 +104,34 @@ const vector<int>& Graph::getNeighbors(const int& src)
     return *neighbors;
 }
 
+/**
+ * @brief 获取顶点的出边区间，不存在的顶点返回空区间，不会向adjList插入新项
+ * 
+ * @param src 顶点名
+ * @return 出边区间
+ */
+EdgeRange Graph::edges(const int& src) const
+{
+    auto it = adjList.find(src);
+    if(it == adjList.end())
+        return EdgeRange();
+    return EdgeRange(it->second.data(), it->second.data() + it->second.size());
+}
+
+/**
+ * @brief 扫描全部边求最大边权，供Dial桶队列确定桶数
+ * 
+ * @return 最大边权，没有边时为0
+ */
+int Graph::getMaxWeight() const
+{
+    int weight = 0;
+    for(const auto& list : adjList)
+        for(const Edge& edge : list.second)
+            weight = max(weight, edge.weight);
+    return weight;
+}
+
 const Graph& Graph::buildGraphFromtxt(const string& filePath)
 {
     ifstream file(filePath);
@@ -117,68 +152,144 @@ const Graph& Graph::buildGraphFromtxt(const string& filePath)
     return *this;
 }
 
-const int dijkstra(Graph& graph, const int& src, const int& dest, FibHeap& queue)
+/**
+ * @brief 直接从DIMACS .gr文件建图，按头部给出的顶点数预留哈希表
+ * 
+ * @param filePath .gr文件路径
+ * @return 构建完成的图
+ */
+const Graph& Graph::buildGraphFromgr(const string& filePath)
 {
-    vector<int> dist(graph.getV(), MAX);//2147483647
-    vector<bool> visited(graph.getV(), false);
-    dist[src] = 0;
-    queue.insert(0, src);
-    while(!queue.isEmpty())
-    {
-        int u = 0;
-        if(!queue.minimum(&u))
-            throw "unable to get minimum";
-        queue.removeMin();
-        visited[u] = true;
-        if(u == dest)
-            break;
-        for(auto it : graph.adjList[u])
-        {
-            int v = it.dest;
-            int weight = it.weight;
-            if(!visited[v] && dist[u] + weight < dist[v])
-            {
-                dist[v] = dist[u] + weight;
-                queue.update(v, dist[v]);
-            }
-        }
-    }
-    if(dist[dest] == MAX)
-    {
-        throw "Path Not Found";
-    }
-    return dist[dest];
+    GrReader reader(filePath);
+    adjList.reserve(reader.getV());
+    int src, dest, weight;
+    while(reader.next(src, dest, weight))
+        addEdge(src, dest, weight);
+    return *this;
+}
+
+/**
+ * @brief 构建反图，每条边(u,v,w)变为(v,u,w)，顶点编号上界保持不变
+ * 
+ * @return 反图
+ */
+Graph Graph::reverse() const
+{
+    Graph reversed;
+    reversed.adjList.reserve(adjList.size());
+    for(auto& entry : adjList)
+        for(const Edge& edge : entry.second)
+            reversed.addEdge(edge.dest, entry.first, edge.weight);
+    reversed.maxVertex = maxVertex;
+    return reversed;
 }
 
-const int dijkstra(Graph& graph, const int& src, const int& dest, Binomial_Queue& queue)
+/**
+ * @brief 开始新一次查询：代数加2使旧标签全部失效，数组只在图变大时扩容
+ * 
+ * 代数即将回绕时才整体清零一次。
+ * 
+ * @param bound 顶点编号上界
+ */
+void DijkstraWorkspace::prepare(int bound)
 {
-    vector<int> dist(graph.getV(), MAX);//2147483647
-    vector<bool> visited(graph.getV(), false);
-    dist[src] = 0;
-    queue.insert(0, src);
-    while(!queue.isEmpty())
+    if((int)labels.size() < bound)
+        labels.resize(bound, Label{MAX, 0});
+    if(generation >= UINT_MAX - 3)
     {
-        int u = 0;
-        if(!queue.minimum(&u))
-            throw "unable to get minimum";
-        queue.removeMin();
-        visited[u] = true;
-        if(u == dest)
-            break;
-        for(auto it : graph.adjList[u])
-        {
-            int v = it.dest;
-            int weight = it.weight;
-            if(!visited[v] && dist[u] + weight < dist[v])
-            {
-                dist[v] = dist[u] + weight;
-                queue.insert(dist[v], v);
-            }
-        }
+        for(Label& label : labels)
+            label.stamp = 0;
+        for(unsigned& mark : marks)
+            mark = 0;
+        generation = 0;
     }
-    if(dist[dest] == MAX)
+    generation += 2;
+}
+
+/**
+ * @brief 需要路径时为前驱数组分配空间，同样只在图变大时扩容
+ * 
+ * @param bound 顶点编号上界
+ */
+void DijkstraWorkspace::prepareParents(int bound)
+{
+    if((int)parents.size() < bound)
+        parents.resize(bound, -1);
+}
+
+/**
+ * @brief 一对多查询时为目标标记分配空间，须在prepare之后调用
+ * 
+ * @param bound 顶点编号上界
+ */
+void DijkstraWorkspace::prepareTargets(int bound)
+{
+    if((int)marks.size() < bound)
+        marks.resize(bound, 0);
+}
+
+/**
+ * @brief 把顶点标记为本次查询的目标
+ * 
+ * @param v 顶点编号
+ * @return 是否为新标记，重复的目标返回false
+ */
+bool DijkstraWorkspace::markTarget(int v)
+{
+    if(marks[v] == generation)
+        return false;
+    marks[v] = generation;
+    return true;
+}
+
+/**
+ * @brief 查询某顶点在最短路树中的前驱
+ * 
+ * @param name 顶点名
+ * @return 前驱的顶点名，起点返回-1；顶点不在图中或未到达抛出"Vertex not reached"
+ */
+int QueryResult::predecessor(const int& name) const
+{
+    int v = csr != nullptr ? csr->index(name) : name;
+    if(workspace == nullptr || v < 0 || v >= bound || workspace->distance(v) == MAX)
+        throw "Vertex not reached";
+    int p = workspace->parent(v);
+    if(p == -1)
+        return -1;
+    return csr != nullptr ? csr->name(p) : p;
+}
+
+/**
+ * @brief 展开起点到终点的顶点序列，O(路径长度)
+ * 
+ * @return 顶点名序列，含起点和终点
+ */
+vector<int> QueryResult::path() const
+{
+    vector<int> vertices;
+    if(workspace == nullptr || distance == MAX)
+        return vertices;
+    for(int v = t; v != -1; v = v == s ? -1 : workspace->parent(v))
+        vertices.push_back(csr != nullptr ? csr->name(v) : v);
+    reverse(vertices.begin(), vertices.end());
+    return vertices;
+}
+
+/**
+ * @brief 展开路径上的边序列，O(路径长度)
+ * 
+ * @return 每条边的终点名和权值，按从起点到终点的顺序
+ */
+vector<Edge> QueryResult::edges() const
+{
+    vector<Edge> hops;
+    if(workspace == nullptr || distance == MAX)
+        return hops;
+    for(int v = t; v != s; v = workspace->parent(v))
     {
-        throw "Path Not Found";
+        int p = workspace->parent(v);
+        hops.push_back(Edge(csr != nullptr ? csr->name(v) : v, workspace->distance(v) - workspace->distance(p)));
     }
-    return dist[dest];
-}
\ No newline at end of file
+    reverse(hops.begin(), hops.end());
+    return hops;
+}
@@ -0,0 +1,139 @@
+#include "default.h"
+#include "Distance_Matrix.h"
+#include <thread>
+#include <atomic>
+
+using namespace std;
+
+/**
+ * @brief 准备每个线程的工作区和堆
+ * 
+ * @param ch 已构建的收缩层次，生命周期需长于本对象
+ * @param threads 线程数，0表示使用硬件线程数
+ */
+DistanceMatrix::DistanceMatrix(const ContractionHierarchy& ch, int threads)
+    : ch(ch), threads(threads)
+{
+    if(this->threads <= 0)
+        this->threads = max(1u, thread::hardware_concurrency());
+    workspaces.resize(this->threads);
+    for(int i = 0; i < this->threads; i++)
+        queues.emplace_back(4, ch.getV());
+}
+
+/**
+ * @brief 从s出发只沿向上的边做完整的Dijkstra，每确定一个顶点调用一次visit
+ * 
+ * 多对多查询没有单一终点可供剪枝，搜索空间就是s的整个向上闭包，在路网上只有几百个顶点。
+ */
+template<class Visit>
+static void upwardSearch(const ContractionHierarchy& ch, bool forward, int s, Binary_Heap& queue,
+                         DijkstraWorkspace& space, Visit visit)
+{
+    space.prepare(ch.getV());
+    space.reach(s, 0);
+    queue.insert(0, s);
+    while(!queue.isEmpty())
+    {
+        int u = 0;
+        queue.minimum(&u);
+        queue.removeMin();
+        space.settle(u);
+        int du = space.distance(u);
+        visit(u, du);
+        for(const Edge& edge : forward ? ch.upward(u) : ch.downward(u))
+        {
+            int v = edge.dest;
+            if(!space.settled(v) && du + edge.weight < space.distance(v))
+            {
+                space.reach(v, du + edge.weight);
+                queue.update(v, du + edge.weight);
+            }
+        }
+    }
+}
+
+/**
+ * @brief 在n个任务上并行执行job(线程编号, 任务下标)，用共享计数器分配任务
+ */
+template<class Job>
+static void parallelFor(int threads, int n, Job job)
+{
+    atomic<int> next(0);
+    auto run = [&](int id){
+        int i;
+        while((i = next.fetch_add(1)) < n)
+            job(id, i);
+    };
+    threads = max(1, min(threads, n));
+    vector<thread> workers;
+    for(int id = 1; id < threads; id++)
+        workers.emplace_back(run, id);
+    run(0);
+    for(thread& worker : workers)
+        worker.join();
+}
+
+/**
+ * @brief 反向阶段：各线程先把桶项写入自己的缓冲，再按顶点计数排序合并成CSR
+ * 
+ * @param targets 终点的内部编号，-1表示不存在
+ */
+void DistanceMatrix::fillBuckets(const vector<int>& targets)
+{
+    vector<vector<pair<int, BucketEntry>>> local(threads);
+    parallelFor(threads, (int)targets.size(), [&](int id, int j){
+        if(targets[j] == -1)
+            return;
+        upwardSearch(ch, false, targets[j], queues[id], workspaces[id], [&](int u, int du){
+            local[id].push_back(make_pair(u, BucketEntry{j, du}));
+        });
+    });
+    int V = ch.getV();
+    bucketOffsets.assign(V + 1, 0);
+    for(const auto& entries : local)
+        for(const auto& entry : entries)
+            bucketOffsets[entry.first + 1]++;
+    for(int u = 0; u < V; u++)
+        bucketOffsets[u + 1] += bucketOffsets[u];
+    buckets.resize(bucketOffsets[V]);
+    vector<int> fill(bucketOffsets.begin(), bucketOffsets.end() - 1);
+    for(const auto& entries : local)
+        for(const auto& entry : entries)
+            buckets[fill[entry.first]++] = entry.second;
+}
+
+/**
+ * @brief 计算sources×targets的距离表
+ * 
+ * @param sources 起点(原顶点名)
+ * @param targets 终点(原顶点名)
+ * @return 行主序的稠密矩阵，第i行第j列为sources[i]到targets[j]的距离，
+ *         不可达或顶点不存在为MAX
+ */
+vector<int> DistanceMatrix::compute(const vector<int>& sources, const vector<int>& targets)
+{
+    int N = sources.size(), M = targets.size();
+    vector<int> matrix((size_t)N * M, MAX);
+    if(N == 0 || M == 0)
+        return matrix;
+    vector<int> ids(M);
+    for(int j = 0; j < M; j++)
+        ids[j] = ch.index(targets[j]);
+    fillBuckets(ids);
+    parallelFor(threads, N, [&](int id, int i){
+        int s = ch.index(sources[i]);
+        if(s == -1)
+            return;
+        int* row = matrix.data() + (size_t)i * M;
+        upwardSearch(ch, true, s, queues[id], workspaces[id], [&](int u, int du){
+            for(int k = bucketOffsets[u]; k < bucketOffsets[u + 1]; k++)
+            {
+                const BucketEntry& entry = buckets[k];
+                if(du + entry.dist < row[entry.target])
+                    row[entry.target] = du + entry.dist;
+            }
+        });
+    });
+    return matrix;
+}
@@ -1,14 +1,30 @@
 #include "Fib_Heap.h"
 #include "default.h"
+#include "Search_Stats.h"
 
 using namespace std;
 
-FibHeap::FibHeap()
+FibHeap::FibHeap():epoch(1)
 {
     keyNum = 0;
-    maxDegree = 0;
     min = NULL;
-    cons = NULL;
+    occupied = 0;
+    consLimit = 0;
+}
+
+/**
+ * @brief 按顶点数预分配句柄索引
+ * 
+ * @param capacity 顶点编号上界，用于预分配句柄索引和度数表
+ */
+FibHeap::FibHeap(int capacity):epoch(1)
+{
+    keyNum = 0;
+    min = NULL;
+    occupied = 0;
+    consLimit = capacity;
+    cons.assign(degreeBound(capacity), NULL);
+    handles.assign(capacity, NULL);
 }
 
 FibHeap::~FibHeap()
@@ -81,10 +97,10 @@ void FibHeap::insert(int key, int vertex)
 {
     FibNode *node;
 
-    node = new FibNode(key, vertex);
-    if (node == NULL)
-        return;
+    node = pool.alloc(key, vertex);
+    node->epoch = epoch;
 
+    setHandle(vertex, node);
     insert(node);
 }
 
@@ -114,18 +130,30 @@ void FibHeap::combine(FibHeap *other)
 {
     if (other == NULL)
         return;
-    if (other->maxDegree > this->maxDegree)
-        swap(*this, *other);
+    // 两个堆统一到同一代数，失效句柄清空，之后节点和内存池一起并入this
+    unsigned next = std::max(epoch, other->epoch) + 1;
+    restamp(next);
+    other->restamp(next);
+    if (other->consLimit > this->consLimit) // 逐个交换成员，整体swap会经由临时对象析构掉节点
+    {
+        swap(this->keyNum, other->keyNum);
+        swap(this->min, other->min);
+        this->cons.swap(other->cons);
+        swap(this->consLimit, other->consLimit);
+        this->handles.swap(other->handles);
+        this->pool.swap(other->pool);
+    }
     if ((this->min) == NULL) // this无"最小节点"
     {
         this->min = other->min;
         this->keyNum = other->keyNum;
-        free(other->cons);
+        this->handles.swap(other->handles);
+        pool.adopt(other->pool);
         delete other;
     }
     else if ((other->min) == NULL) // this有"最小节点" && other无"最小节点"
     {
-        free(other->cons);
+        pool.adopt(other->pool);
         delete other;
     } // this有"最小节点" && other有"最小节点"
     else
@@ -136,7 +164,11 @@ void FibHeap::combine(FibHeap *other)
         if (this->min->key > other->min->key)
             this->min = other->min;
         this->keyNum += other->keyNum;
-        free(other->cons);
+        // 合并句柄索引
+        for (size_t i = 0; i < other->handles.size(); i++)
+            if (other->handles[i] != NULL)
+                setHandle(i, other->handles[i]);
+        pool.adopt(other->pool);
         delete other;
     }
 }
@@ -170,6 +202,7 @@ FibNode *FibHeap::extractMin()
  */
 void FibHeap::link(FibNode *node, FibNode *root)
 {
+    SEARCH_STAT(searchStats.link());
     // 将node从双链表中移除
     removeNode(node);
     // 将node设为root的孩子
@@ -184,36 +217,43 @@ void FibHeap::link(FibNode *node, FibNode *root)
 }
 
 /**
- * @brief 创建consolidate所需空间
+ * @brief n个节点的斐波那契堆中度数的上界
+ * 
+ * 度数为d的树至少有F(d+2)个节点，故d <= log_phi(n) < 1.45*log2(n)，
+ * log2用前导零计数求得，取1.5倍再加2留出余量。
+ * 
+ * @param n 节点数
+ * @return 度数表的项数
  */
-void FibHeap::makeCons()
+int FibHeap::degreeBound(int n)
 {
-    int old = maxDegree;
+    int lg = 31 - __builtin_clz((unsigned)n | 1);
+    return lg + (lg >> 1) + 2;
+}
 
-    // 计算log2(keyNum)，"+1"意味着向上取整！
-    // ex. log2(13) = 3，向上取整为3+1=4。
-    maxDegree = (log(keyNum) / log(2.0)) + 1;
-    if (old >= maxDegree)
+/**
+ * @brief 节点数超过度数表的分配依据时才扩充，平时不做任何事
+ */
+void FibHeap::makeCons()
+{
+    if (keyNum <= consLimit)
         return;
-
-    // 因为度为maxDegree可能被合并，所以要maxDegree+1
-    cons = (FibNode **)realloc(cons,
-                                sizeof(FibHeap *) * (maxDegree + 1));
+    consLimit = std::max(keyNum, consLimit * 2);
+    cons.resize(degreeBound(consLimit), NULL);
 }
 
 /**
  * @brief 合并斐波那契堆的根链表中左右相同度数的树
+ * 
+ * 度数表在两次合并之间保持全空，不需要清零；位图记录非空槽位，
+ * 重建根链表时只访问这些槽位。
  */
 void FibHeap::consolidate()
 {
-    int i, d, D;
-    FibNode *x, *y, *tmp;
+    int d;
+    FibNode *x, *y;
 
-    makeCons(); //开辟哈希所用空间
-    D = maxDegree + 1;
-
-    for (i = 0; i < D; i++)
-        cons[i] = NULL;
+    makeCons();
 
     // 合并相同度的根节点，使每个度数的树唯一
     while (min != NULL)
@@ -229,25 +269,26 @@ void FibHeap::consolidate()
 
             link(y, x); // 将y链接到x中
             cons[d] = NULL;
+            occupied &= ~(1ULL << d);
             d++;
         }
         cons[d] = x;
+        occupied |= 1ULL << d;
     }
     min = NULL;
     // 将cons中的结点重新加到根表中
-    for (i = 0; i < D; i++)
+    for (; occupied != 0; occupied &= occupied - 1)
     {
-        if (cons[i] != NULL)
+        int i = __builtin_ctzll(occupied);
+        if (min == NULL)
+            min = cons[i];
+        else
         {
-            if (min == NULL)
+            addNode(cons[i], min);
+            if ((cons[i])->key < min->key)
                 min = cons[i];
-            else
-            {
-                addNode(cons[i], min);
-                if ((cons[i])->key < min->key)
-                    min = cons[i];
-            }
         }
+        cons[i] = NULL;
     }
 }
 
@@ -288,7 +329,8 @@ void FibHeap::removeMin()
     }
     keyNum--;
 
-    delete m;
+    handles[m->vertex] = NULL;
+    pool.release(m);
 }
 
 /**
@@ -306,19 +348,6 @@ bool FibHeap::minimum(int *pkey)
     return true;
 }
 
-/**
- * @brief 修改节点的度数
- * 
- * @param parent 父节点
- * @param degree 度数
- */
-void FibHeap::renewDegree(FibNode *parent, int degree)
-{
-    parent->degree -= degree;
-    if (parent->parent != NULL)
-        renewDegree(parent->parent, degree);
-}
-
 /**
  * @brief 将节点从父节点parent的子链接中剥离出来，并使其成为堆的根链表中的一员
  * 
@@ -327,8 +356,10 @@ void FibHeap::renewDegree(FibNode *parent, int degree)
  */
 void FibHeap::cut(FibNode *node, FibNode *parent)
 {
+    SEARCH_STAT(searchStats.cut());
     removeNode(node);
-    renewDegree(parent, node->degree);
+    // 度数只统计直接孩子，剥离一个孩子只需减一
+    parent->degree--;
     // node没有兄弟
     if (node == node->right)
         parent->child = NULL;
@@ -470,7 +501,7 @@ void FibHeap::update(FibNode *node, int key)
 }
 
 /**
- * @brief 更新节点的键值为key
+ * @brief 更新节点的键值为key，顶点不在堆中时插入，通过句柄索引O(1)定位
  * 
  * @param vertex 要更新的节点的顶点
  * @param newkey 新键值
@@ -487,47 +518,33 @@ void FibHeap::update(int vertex, int newkey)
 }
 
 /**
- * @brief 在最小堆中查找节点
+ * @brief 在斐波那契堆中查找节点，直接读取句柄索引
  * 
- * @param root 根节点
  * @param vertex 要查找的节点的顶点
  * @return 节点指针，如果找到则返回指向该节点的指针，否则返回NULL
  */
-FibNode *FibHeap::search(FibNode *root, int vertex)
+FibNode *FibHeap::search(int vertex)
 {
-    FibNode *t = root; // 临时节点
-    FibNode *p = NULL; // 要查找的节点
-    if (root == NULL)
-        return root;
-    do
-    {
-        if (t->vertex == vertex)
-        {
-            p = t;
-            break;
-        }
-        else
-        {
-            if ((p = search(t->child, vertex)) != NULL)
-                break;
-        }
-        t = t->right;
-    } while (t != root);
-    return p;
+    if (vertex < 0 || vertex >= (int)handles.size())
+        return NULL;
+
+    FibNode *node = handles[vertex];
+    if (node == NULL || node->epoch != epoch || node->vertex != vertex)
+        return NULL;
+    return node;
 }
 
 /**
- * @brief 在斐波那契堆中查找节点
+ * @brief 记录顶点对应的节点，索引不足时扩容
  * 
- * @param vertex 要查找的节点的顶点
- * @return 节点指针，如果找到则返回指向该节点的指针，否则返回NULL
+ * @param vertex 顶点
+ * @param node 节点指针
  */
-FibNode *FibHeap::search(int vertex)
+void FibHeap::setHandle(int vertex, FibNode *node)
 {
-    if (min == NULL)
-        return NULL;
-
-    return search(min, vertex);
+    if (vertex >= (int)handles.size())
+        handles.resize(max(vertex + 1, (int)handles.size() * 2), NULL);
+    handles[vertex] = node;
 }
 
 /**
@@ -554,18 +571,18 @@ void FibHeap::remove(FibNode *node)
 }
 
 /**
- * @brief 删除具有特定键值的节点
+ * @brief 删除特定顶点对应的节点
  * 
- * @param key 节点的键值
+ * @param vertex 节点的顶点
  */
-void FibHeap::remove(int key)
+void FibHeap::remove(int vertex)
 {
     FibNode *node;
 
     if (min == NULL)
         return;
 
-    node = search(key);
+    node = search(vertex);
     if (node == NULL)
         return;
 
@@ -573,29 +590,36 @@ void FibHeap::remove(int key)
 }
 
 /**
- * @brief 销毁斐波那契节点
+ * @brief 把仍有效的节点改记为新代数，失效句柄清空，O(句柄数)
+ * 
+ * @param next 新代数
  */
-void FibHeap::destroyNode(FibNode *node)
+void FibHeap::restamp(unsigned next)
 {
-    FibNode *start = node;
-    if (node == NULL)
-        return;
-    do
+    for (size_t i = 0; i < handles.size(); i++)
     {
-        destroyNode(node->child);
-        // 销毁node，并将node指向下一个
-        node = node->right;
-        delete node->left;
-    } while (node != start);
+        FibNode *node = search(i);
+        if (node != NULL)
+            node->epoch = next;
+        else
+            handles[i] = NULL;
+    }
+    epoch = next;
 }
 
 /**
- * @brief 销毁斐波那契节点
+ * @brief 清空堆，O(1)：节点内存整体交还内存池，代数加1使所有旧句柄失效
  */
 void FibHeap::destroy()
 {
-    destroyNode(min);
-    free(cons);
+    pool.reset();
+    min = NULL;
+    keyNum = 0;
+    if (++epoch == 0) // 代数回绕时才真正清空句柄
+    {
+        handles.assign(handles.size(), NULL);
+        epoch = 1;
+    }
 }
 
 
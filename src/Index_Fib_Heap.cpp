@@ -0,0 +1,314 @@
+#include "Index_Fib_Heap.h"
+#include "Search_Stats.h"
+#include <climits>
+
+/**
+ * @brief 构造下标版斐波那契堆
+ * 
+ * @param capacity 顶点编号上界，用于预分配节点数组
+ */
+Index_Fib_Heap::Index_Fib_Heap(int capacity):epoch(1), min(NIL), keyNum(0)
+{
+    for(int d = 0; d < MAX_DEGREE; d++)
+        cons[d] = NIL;
+    grow(capacity - 1);
+}
+
+Index_Fib_Heap::~Index_Fib_Heap()
+{
+}
+
+/**
+ * @brief 顶点编号超出已分配范围时扩充节点数组
+ * 
+ * @param vertex 顶点
+ */
+void Index_Fib_Heap::grow(int vertex)
+{
+    if(vertex < (int)nodes.size())
+        return;
+    nodes.resize(max(vertex + 1, (int)nodes.size() * 2));
+}
+
+/**
+ * @brief 判断堆是否为空
+ * 
+ * @return 如果为空，则返回true；如果非空，则返回false
+ */
+bool Index_Fib_Heap::isEmpty()
+{
+    return min == NIL;
+}
+
+/**
+ * @brief 获取堆中元素个数
+ * 
+ * @return 元素个数
+ */
+int Index_Fib_Heap::size()
+{
+    return keyNum;
+}
+
+/**
+ * @brief 获取最小键值对应的顶点
+ * 
+ * @param pkey 用于存储最小键值对应顶点的指针
+ * @return 堆非空返回true，否则返回false
+ */
+bool Index_Fib_Heap::minimum(int *pkey)
+{
+    if(min == NIL || pkey == nullptr)
+        return false;
+    *pkey = min;
+    return true;
+}
+
+/**
+ * @brief 把节点加入根链表(min的左侧)并更新min
+ */
+void Index_Fib_Heap::addRoot(int node)
+{
+    nodes[node].parent = NIL;
+    nodes[node].marked = 0;
+    if(min == NIL)
+    {
+        nodes[node].left = nodes[node].right = node;
+        min = node;
+        return;
+    }
+    nodes[node].left = nodes[min].left;
+    nodes[nodes[min].left].right = node;
+    nodes[node].right = min;
+    nodes[min].left = node;
+    if(nodes[node].key < nodes[min].key)
+        min = node;
+}
+
+/**
+ * @brief 插入键值
+ * 
+ * @param key 键值
+ * @param vertex 顶点
+ */
+void Index_Fib_Heap::insert(int key, int vertex)
+{
+    grow(vertex);
+    if(nodes[vertex].stamp == epoch)
+        throw "alreay exists";
+    nodes[vertex].stamp = epoch;
+    nodes[vertex].key = key;
+    nodes[vertex].child = NIL;
+    nodes[vertex].degree = 0;
+    addRoot(vertex);
+    keyNum++;
+}
+
+/**
+ * @brief 把node挂为root的孩子，二者都来自consolidate暂存的根
+ */
+void Index_Fib_Heap::link(int node, int root)
+{
+    SEARCH_STAT(searchStats.link());
+    int c = nodes[root].child;
+    if(c == NIL)
+    {
+        nodes[root].child = node;
+        nodes[node].left = nodes[node].right = node;
+    }
+    else
+    {
+        nodes[node].left = nodes[c].left;
+        nodes[nodes[c].left].right = node;
+        nodes[node].right = c;
+        nodes[c].left = node;
+    }
+    nodes[node].parent = root;
+    nodes[node].marked = 0;
+    nodes[root].degree++;
+}
+
+/**
+ * @brief 合并度数相同的根，再由度数表重建根链表
+ */
+void Index_Fib_Heap::consolidate()
+{
+    roots.clear();
+    int start = min;
+    int x = start;
+    do
+    {
+        roots.push_back(x);
+        x = nodes[x].right;
+    } while(x != start);
+
+    int top = 0;
+    for(int r : roots)
+    {
+        int x = r;
+        int d = nodes[x].degree;
+        while(cons[d] != NIL)
+        {
+            int y = cons[d];
+            if(nodes[y].key < nodes[x].key)
+                swap(x, y);
+            link(y, x);
+            cons[d] = NIL;
+            d++;
+        }
+        cons[d] = x;
+        top = max(top, d);
+    }
+    min = NIL;
+    for(int d = 0; d <= top; d++)
+    {
+        if(cons[d] != NIL)
+        {
+            addRoot(cons[d]);
+            cons[d] = NIL;
+        }
+    }
+}
+
+/**
+ * @brief 移除最小键值：孩子并入根链表后合并
+ */
+void Index_Fib_Heap::removeMin()
+{
+    if(min == NIL)
+        return;
+    int z = min;
+    int c = nodes[z].child;
+    if(c != NIL)
+    {
+        int x = c;
+        do
+        {
+            nodes[x].parent = NIL;
+            nodes[x].marked = 0;
+            x = nodes[x].right;
+        } while(x != c);
+        // 把孩子链表整体接到z的右侧
+        int zr = nodes[z].right, cl = nodes[c].left;
+        nodes[z].right = c;
+        nodes[c].left = z;
+        nodes[cl].right = zr;
+        nodes[zr].left = cl;
+    }
+    nodes[z].stamp = 0;
+    keyNum--;
+    if(nodes[z].right == z)
+    {
+        min = NIL;
+        return;
+    }
+    nodes[nodes[z].left].right = nodes[z].right;
+    nodes[nodes[z].right].left = nodes[z].left;
+    min = nodes[z].right;
+    consolidate();
+}
+
+/**
+ * @brief 把node从父节点p的孩子链表中剪下，加入根链表
+ */
+void Index_Fib_Heap::cut(int node, int p)
+{
+    SEARCH_STAT(searchStats.cut());
+    if(nodes[node].right == node)
+        nodes[p].child = NIL;
+    else
+    {
+        if(nodes[p].child == node)
+            nodes[p].child = nodes[node].right;
+        nodes[nodes[node].left].right = nodes[node].right;
+        nodes[nodes[node].right].left = nodes[node].left;
+    }
+    nodes[p].degree--;
+    addRoot(node);
+}
+
+/**
+ * @brief 级联剪切：沿父链剪下已标记的祖先，遇到未标记的祖先时标记后停止
+ */
+void Index_Fib_Heap::cascadingCut(int node)
+{
+    int p = nodes[node].parent;
+    while(p != NIL)
+    {
+        if(!nodes[node].marked)
+        {
+            nodes[node].marked = 1;
+            return;
+        }
+        cut(node, p);
+        node = p;
+        p = nodes[node].parent;
+    }
+}
+
+/**
+ * @brief 降键，违反堆序时剪下并级联剪切
+ */
+void Index_Fib_Heap::decrease(int node, int newkey)
+{
+    nodes[node].key = newkey;
+    int p = nodes[node].parent;
+    if(p != NIL && newkey < nodes[p].key)
+    {
+        cut(node, p);
+        cascadingCut(p);
+    }
+    if(newkey < nodes[min].key)
+        min = node;
+}
+
+/**
+ * @brief 判断顶点是否在堆中
+ * 
+ * @param vertex 顶点
+ * @return 在堆中返回true，否则返回false
+ */
+bool Index_Fib_Heap::contains(int vertex)
+{
+    return vertex >= 0 && vertex < (int)nodes.size() && nodes[vertex].stamp == epoch;
+}
+
+/**
+ * @brief 修改顶点的键值，顶点不在堆中时插入
+ * 
+ * 增键时先降到最小值取出，再以新键值重新插入。
+ * 
+ * @param vertex 顶点
+ * @param newkey 新键值
+ */
+void Index_Fib_Heap::update(int vertex, int newkey)
+{
+    if(!contains(vertex))
+    {
+        insert(newkey, vertex);
+        return;
+    }
+    if(newkey < nodes[vertex].key)
+        decrease(vertex, newkey);
+    else if(newkey > nodes[vertex].key)
+    {
+        decrease(vertex, INT_MIN);
+        removeMin();
+        insert(newkey, vertex);
+    }
+}
+
+/**
+ * @brief 清空堆，O(1)：代数加1使所有节点的stamp失效
+ */
+void Index_Fib_Heap::destroy()
+{
+    min = NIL;
+    keyNum = 0;
+    if(++epoch == 0) // 代数回绕时才真正清空
+    {
+        for(IndexFibNode& node : nodes)
+            node.stamp = 0;
+        epoch = 1;
+    }
+}
@@ -0,0 +1,235 @@
+#include "Pairing_Heap.h"
+#include "Search_Stats.h"
+
+/**
+ * @brief 构造配对堆
+ * 
+ * @param capacity 顶点编号上界，用于预分配句柄索引
+ */
+Pairing_Heap::Pairing_Heap(int capacity):root(nullptr), keyNum(0)
+{
+    handles.assign(capacity, nullptr);
+}
+
+Pairing_Heap::~Pairing_Heap()
+{
+}
+
+/**
+ * @brief 判断堆是否为空
+ * 
+ * @return 如果为空，则返回true；如果非空，则返回false
+ */
+bool Pairing_Heap::isEmpty()
+{
+    return root == nullptr;
+}
+
+/**
+ * @brief 获取堆中元素个数
+ * 
+ * @return 元素个数
+ */
+int Pairing_Heap::size()
+{
+    return keyNum;
+}
+
+/**
+ * @brief 获取最小键值对应的顶点
+ * 
+ * @param pkey 用于存储最小键值对应顶点的指针
+ * @return 堆非空返回true，否则返回false
+ */
+bool Pairing_Heap::minimum(int *pkey)
+{
+    if(root == nullptr || pkey == nullptr)
+        return false;
+    *pkey = root->vertex;
+    return true;
+}
+
+/**
+ * @brief 合并两棵树，键值大的根成为另一根的第一个孩子
+ * 
+ * @return 新的根
+ */
+PairNode* Pairing_Heap::meld(PairNode *a, PairNode *b)
+{
+    if(a == nullptr)
+        return b;
+    if(b == nullptr)
+        return a;
+    SEARCH_STAT(searchStats.link());
+    if(b->key < a->key)
+        swap(a, b);
+    b->prev = a;
+    b->next = a->child;
+    if(a->child != nullptr)
+        a->child->prev = b;
+    a->child = b;
+    a->next = nullptr;
+    a->prev = nullptr;
+    return a;
+}
+
+/**
+ * @brief 把以node为根的子树从其父节点的孩子链表中剪下
+ */
+void Pairing_Heap::cut(PairNode *node)
+{
+    SEARCH_STAT(searchStats.cut());
+    if(node->prev->child == node)
+        node->prev->child = node->next;
+    else
+        node->prev->next = node->next;
+    if(node->next != nullptr)
+        node->next->prev = node->prev;
+    node->next = nullptr;
+    node->prev = nullptr;
+}
+
+/**
+ * @brief 两趟合并：从左到右两两合并，再从右到左依次并入
+ * 
+ * @param first 孩子链表的第一个节点
+ * @return 合并后的根
+ */
+PairNode* Pairing_Heap::mergePairs(PairNode *first)
+{
+    pairs.clear();
+    while(first != nullptr)
+    {
+        PairNode *a = first;
+        PairNode *b = a->next;
+        first = b != nullptr ? b->next : nullptr;
+        a->next = a->prev = nullptr;
+        if(b != nullptr)
+            b->next = b->prev = nullptr;
+        pairs.push_back(meld(a, b));
+    }
+    PairNode *result = nullptr;
+    for(int i = (int)pairs.size() - 1; i >= 0; i--)
+        result = meld(pairs[i], result);
+    return result;
+}
+
+/**
+ * @brief 按顶点查找节点，O(1)
+ */
+PairNode* Pairing_Heap::search(int vertex)
+{
+    if(vertex < 0 || vertex >= (int)handles.size())
+        return nullptr;
+    return handles[vertex];
+}
+
+void Pairing_Heap::setHandle(int vertex, PairNode *node)
+{
+    if(vertex >= (int)handles.size())
+        handles.resize(vertex + 1, nullptr);
+    handles[vertex] = node;
+}
+
+/**
+ * @brief 插入键值
+ * 
+ * @param key 键值
+ * @param vertex 顶点
+ */
+void Pairing_Heap::insert(int key, int vertex)
+{
+    if(search(vertex) != nullptr)
+        throw "alreay exists";
+    PairNode *node = pool.alloc(key, vertex);
+    setHandle(vertex, node);
+    root = meld(root, node);
+    keyNum++;
+}
+
+/**
+ * @brief 移除最小键值
+ */
+void Pairing_Heap::removeMin()
+{
+    if(root == nullptr)
+        return;
+    PairNode *old = root;
+    root = mergePairs(old->child);
+    handles[old->vertex] = nullptr;
+    pool.release(old);
+    keyNum--;
+}
+
+/**
+ * @brief 判断顶点是否在堆中
+ * 
+ * @param vertex 顶点
+ * @return 在堆中返回true，否则返回false
+ */
+bool Pairing_Heap::contains(int vertex)
+{
+    return search(vertex) != nullptr;
+}
+
+/**
+ * @brief 修改顶点的键值，顶点不在堆中时插入
+ * 
+ * 降键时剪下子树与根合并；增键时先把节点的孩子两趟合并后放回，再把节点单独并入。
+ * 
+ * @param vertex 顶点
+ * @param newkey 新键值
+ */
+void Pairing_Heap::update(int vertex, int newkey)
+{
+    PairNode *node = search(vertex);
+    if(node == nullptr)
+    {
+        insert(newkey, vertex);
+        return;
+    }
+    if(newkey < node->key)
+    {
+        node->key = newkey;
+        if(node != root)
+        {
+            cut(node);
+            root = meld(root, node);
+        }
+    }
+    else if(newkey > node->key)
+    {
+        node->key = newkey;
+        PairNode *children = mergePairs(node->child);
+        node->child = nullptr;
+        if(node == root)
+            root = children;
+        else
+        {
+            cut(node);
+            root = meld(root, children);
+        }
+        root = meld(root, node);
+    }
+}
+
+/**
+ * @brief 清空堆：沿树重置仍在堆中的句柄，节点内存整体交还内存池
+ */
+void Pairing_Heap::destroy()
+{
+    pairs.clear();
+    if(root != nullptr)
+        pairs.push_back(root);
+    while(!pairs.empty())
+    {
+        PairNode *node = pairs.back();
+        pairs.pop_back();
+        handles[node->vertex] = nullptr;
+        for(PairNode *c = node->child; c != nullptr; c = c->next)
+            pairs.push_back(c);
+    }
+    root = nullptr;
+    keyNum = 0;
+    pool.reset();
+}
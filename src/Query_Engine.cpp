@@ -0,0 +1,98 @@
+#include "default.h"
+#include "Query_Engine.h"
+
+using namespace std;
+
+/**
+ * @brief 创建线程池和每个线程的工作区
+ * 
+ * @param graph 只读共享的图，生命周期需长于引擎
+ * @param threads 线程数，0表示使用硬件线程数
+ */
+BatchQueryEngine::BatchQueryEngine(const Graph& graph, int threads)
+    : graph(graph), batch(nullptr), results(nullptr), nextQuery(0), pending(0), generation(0), stopping(false)
+{
+    if(threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    workspaces.resize(threads);
+    for(int i = 0; i < threads; i++)
+        queues.emplace_back(4, graph.getBound());
+    for(int i = 0; i < threads; i++)
+        workers.emplace_back(&BatchQueryEngine::work, this, i);
+}
+
+/**
+ * @brief 通知所有线程退出并等待结束
+ */
+BatchQueryEngine::~BatchQueryEngine()
+{
+    {
+        lock_guard<mutex> guard(stateLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(thread& worker : workers)
+        worker.join();
+}
+
+/**
+ * @brief 线程主循环：等待新批次，从共享下标领取查询直到领完
+ * 
+ * @param id 线程编号，对应自己的工作区和堆
+ */
+void BatchQueryEngine::work(int id)
+{
+    unsigned long long seen = 0;
+    DijkstraWorkspace& workspace = workspaces[id];
+    Binary_Heap& queue = queues[id];
+    while(true)
+    {
+        unique_lock<mutex> guard(stateLock);
+        wake.wait(guard, [&]{return stopping || generation != seen;});
+        if(stopping)
+            return;
+        seen = generation;
+        const vector<pair<int, int>>& current = *batch;
+        vector<int>& out = *results;
+        guard.unlock();
+
+        size_t i;
+        while((i = nextQuery.fetch_add(1)) < current.size())
+        {
+            try{
+                out[i] = dijkstra(graph, current[i].first, current[i].second, queue, workspace);
+            }catch(const char*){
+                out[i] = INF;
+            }
+        }
+
+        guard.lock();
+        if(--pending == 0)
+            done.notify_all();
+    }
+}
+
+/**
+ * @brief 并行执行一批点到点查询
+ * 
+ * @param queries (起点, 终点)列表
+ * @return 与输入同序的最短距离，不可达或顶点不存在为INF
+ */
+vector<int> BatchQueryEngine::query(const vector<pair<int, int>>& queries)
+{
+    vector<int> distances(queries.size(), INF);
+    if(queries.empty())
+        return distances;
+    lock_guard<mutex> serial(batchLock);
+    unique_lock<mutex> guard(stateLock);
+    batch = &queries;
+    results = &distances;
+    nextQuery = 0;
+    pending = workers.size();
+    generation++;
+    wake.notify_all();
+    done.wait(guard, [&]{return pending == 0;});
+    batch = nullptr;
+    results = nullptr;
+    return distances;
+}
@@ -0,0 +1,187 @@
+#include "default.h"
+#include "Query_Generator.h"
+#include "read_gr_txt.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief 创建生成器
+ *
+ * @param graph 查询所在的图，生命周期需长于生成器
+ * @param seed 随机种子
+ */
+QueryGenerator::QueryGenerator(const CSRGraph& graph, unsigned seed)
+    : graph(graph), rng(seed), queue(4, graph.getBound())
+{
+}
+
+/**
+ * @brief 取[0,n)中的随机数。取模的偏差对查询采样无影响，换来跨平台一致的序列
+ */
+int QueryGenerator::pick(int n)
+{
+    return (int)(rng() % (unsigned)n);
+}
+
+/**
+ * @brief 读取DIMACS .co坐标，按CSR编号存放，图中没有的顶点忽略
+ *
+ * @param filePath .co文件路径
+ */
+void QueryGenerator::loadCoordinates(const string& filePath)
+{
+    CoReader reader(filePath);
+    lon.assign(graph.getBound(), 0);
+    lat.assign(graph.getBound(), 0);
+    int id, x, y;
+    while(reader.next(id, x, y))
+    {
+        int v = graph.index(id);
+        if(v == -1)
+            continue;
+        lon[v] = x;
+        lat[v] = y;
+    }
+}
+
+/**
+ * @brief 两顶点间的地理距离，按等距圆柱投影近似，路网尺度下误差可忽略
+ *
+ * @return 距离(米)
+ */
+double QueryGenerator::geoDistance(int u, int v) const
+{
+    const double radian = 3.14159265358979323846 / 180 / 1e6;
+    const double earth = 6371000;
+    double dx = (lon[v] - lon[u]) * radian * cos((lat[u] + lat[v]) / 2.0 * radian);
+    double dy = (lat[v] - lat[u]) * radian;
+    return earth * sqrt(dx * dx + dy * dy);
+}
+
+/**
+ * @brief 均匀随机的起点和终点
+ *
+ * @param count 查询数
+ * @return 查询集，stratum为-1
+ */
+vector<Query> QueryGenerator::random(int count)
+{
+    vector<Query> queries(count);
+    for(Query& q : queries)
+    {
+        int s = pick(graph.getV());
+        int t = pick(graph.getV());
+        q = Query{graph.name(s), graph.name(t), -1};
+    }
+    return queries;
+}
+
+/**
+ * @brief 按Dijkstra秩分层：从随机起点做一对全部搜索，按确定顺序取第2^k个顶点为终点
+ *
+ * 每个起点对每个k各贡献一条查询，k从minRank起直到超出可达顶点数。
+ * 距离相同时按编号排序，结果与堆的实现无关。
+ *
+ * @param sources 起点数
+ * @param minRank 最小的k
+ * @return 查询集，stratum为k
+ */
+vector<Query> QueryGenerator::byRank(int sources, int minRank)
+{
+    vector<Query> queries;
+    vector<pair<int, int>> order;
+    order.reserve(graph.getBound());
+    for(int i = 0; i < sources; i++)
+    {
+        int s = pick(graph.getV());
+        shortestPathTree(graph, s, nullptr, queue, workspace);
+        order.clear();
+        for(int v = 0; v < graph.getBound(); v++)
+            if(workspace.distance(v) != MAX)
+                order.push_back(make_pair(workspace.distance(v), v));
+        sort(order.begin(), order.end());
+        for(int k = max(minRank, 0); k < 31 && (1u << k) < order.size(); k++)
+            queries.push_back(Query{graph.name(s), graph.name(order[1u << k].second), k});
+    }
+    return queries;
+}
+
+/**
+ * @brief 按地理距离分层：对随机起点，从距离落在[2^k,2^(k+1))米的顶点中各等概率取一个终点
+ *
+ * 每层用蓄水池抽样，扫描一遍顶点即可，不需要存下每层的候选。
+ *
+ * @param sources 起点数
+ * @return 查询集，stratum为k
+ */
+vector<Query> QueryGenerator::byDistance(int sources)
+{
+    if(!hasCoordinates())
+        throw "Coordinates not loaded";
+    const int layers = 32;
+    vector<Query> queries;
+    for(int i = 0; i < sources; i++)
+    {
+        int s = pick(graph.getV());
+        int count[layers] = {0};
+        int chosen[layers] = {0};
+        for(int v = 0; v < graph.getV(); v++)
+        {
+            double d = geoDistance(s, v);
+            if(d < 1)
+                continue;
+            int k = min(layers - 1, (int)log2(d));
+            if(pick(++count[k]) == 0)
+                chosen[k] = v;
+        }
+        for(int k = 0; k < layers; k++)
+            if(count[k] > 0)
+                queries.push_back(Query{graph.name(s), graph.name(chosen[k]), k});
+    }
+    return queries;
+}
+
+/**
+ * @brief 写出查询集，格式仿照DIMACS："c"注释，"p q n"头部，每行"q src dest stratum"
+ *
+ * @param filePath 输出路径
+ * @param queries 查询集
+ * @param comment 写入注释行的说明，如生成方式和种子
+ */
+void QueryGenerator::save(const string& filePath, const vector<Query>& queries, const string& comment)
+{
+    ofstream out(filePath);
+    if(!out.is_open())
+        throw "Unable to open file";
+    out << "c " << comment << "\n";
+    out << "p q " << queries.size() << "\n";
+    for(const Query& q : queries)
+        out << "q " << q.src << ' ' << q.dest << ' ' << q.stratum << "\n";
+}
+
+/**
+ * @brief 读取save写出的查询集
+ *
+ * @param filePath 文件路径
+ * @return 查询集
+ */
+vector<Query> QueryGenerator::load(const string& filePath)
+{
+    ifstream in(filePath);
+    if(!in.is_open())
+        throw "Unable to open file";
+    vector<Query> queries;
+    string line;
+    while(getline(in, line))
+    {
+        if(line.empty() || line[0] != 'q')
+            continue;
+        istringstream iss(line.substr(1));
+        Query q;
+        if(!(iss >> q.src >> q.dest >> q.stratum))
+            throw "Malformed line in query file";
+        queries.push_back(q);
+    }
+    return queries;
+}
@@ -0,0 +1,187 @@
+#include "Radix_Heap.h"
+
+/**
+ * @brief 构造基数堆
+ * 
+ * @param capacity 顶点编号上界，用于预分配索引
+ */
+Radix_Heap::Radix_Heap(int capacity):last(0), count(0)
+{
+    where.assign(capacity, -1);
+    pos.assign(capacity, -1);
+}
+
+Radix_Heap::~Radix_Heap()
+{
+}
+
+/**
+ * @brief 判断堆是否为空
+ * 
+ * @return 如果为空，则返回true；如果非空，则返回false
+ */
+bool Radix_Heap::isEmpty()
+{
+    return count == 0;
+}
+
+/**
+ * @brief 获取堆中元素个数
+ * 
+ * @return 元素个数
+ */
+int Radix_Heap::size()
+{
+    return count;
+}
+
+/**
+ * @brief 顶点编号超出预分配范围时扩充索引
+ * 
+ * @param vertex 顶点
+ */
+void Radix_Heap::grow(int vertex)
+{
+    if(vertex >= (int)where.size())
+    {
+        where.resize(vertex + 1, -1);
+        pos.resize(vertex + 1, -1);
+    }
+}
+
+/**
+ * @brief 把元素放入键值对应的桶并记录位置
+ */
+void Radix_Heap::push(int key, int vertex)
+{
+    int b = bucketOf(key);
+    where[vertex] = b;
+    pos[vertex] = buckets[b].size();
+    buckets[b].push_back(BHEntry(key, vertex));
+}
+
+/**
+ * @brief 把顶点从所在桶中摘除，用桶尾元素填补空位
+ */
+void Radix_Heap::erase(int vertex)
+{
+    vector<BHEntry>& bucket = buckets[where[vertex]];
+    int slot = pos[vertex];
+    bucket[slot] = bucket.back();
+    pos[bucket[slot].vertex] = slot;
+    bucket.pop_back();
+    where[vertex] = -1;
+}
+
+/**
+ * @brief 第0个桶为空时，以第一个非空桶的最小键为新的last重新分配该桶
+ */
+void Radix_Heap::refill()
+{
+    if(!buckets[0].empty())
+        return;
+    int b = 1;
+    while(buckets[b].empty())
+        b++;
+    vector<BHEntry> moving;
+    moving.swap(buckets[b]);
+    last = moving[0].key;
+    for(const BHEntry& entry : moving)
+        last = min(last, entry.key);
+    for(const BHEntry& entry : moving)
+        push(entry.key, entry.vertex);
+    moving.clear();
+    moving.swap(buckets[b]); // 保留原桶的容量
+}
+
+/**
+ * @brief 获取最小键值对应的顶点
+ * 
+ * @param pkey 用于存储最小键值对应顶点的指针
+ * @return 堆非空返回true，否则返回false
+ */
+bool Radix_Heap::minimum(int *pkey)
+{
+    if(count == 0 || pkey == nullptr)
+        return false;
+    refill();
+    *pkey = buckets[0].back().vertex;
+    return true;
+}
+
+/**
+ * @brief 插入键值
+ * 
+ * @param key 键值，不得小于last；堆为空时last归零，便于下一次查询复用
+ * @param vertex 顶点
+ */
+void Radix_Heap::insert(int key, int vertex)
+{
+    grow(vertex);
+    if(where[vertex] != -1)
+        throw "alreay exists";
+    if(count == 0)
+        last = 0;
+    if(key < last)
+        throw "key below last minimum";
+    push(key, vertex);
+    count++;
+}
+
+/**
+ * @brief 移除最小键值
+ */
+void Radix_Heap::removeMin()
+{
+    if(count == 0)
+        return;
+    refill();
+    where[buckets[0].back().vertex] = -1;
+    buckets[0].pop_back();
+    count--;
+}
+
+/**
+ * @brief 判断顶点是否在堆中
+ * 
+ * @param vertex 顶点
+ * @return 在堆中返回true，否则返回false
+ */
+bool Radix_Heap::contains(int vertex)
+{
+    return vertex >= 0 && vertex < (int)where.size() && where[vertex] != -1;
+}
+
+/**
+ * @brief 修改顶点的键值，顶点不在堆中时插入
+ * 
+ * @param vertex 顶点
+ * @param newkey 新键值，不得小于last
+ */
+void Radix_Heap::update(int vertex, int newkey)
+{
+    if(!contains(vertex))
+    {
+        insert(newkey, vertex);
+        return;
+    }
+    if(newkey < last)
+        throw "key below last minimum";
+    erase(vertex);
+    push(newkey, vertex);
+}
+
+/**
+ * @brief 清空堆，只重置仍在堆中的顶点的索引
+ */
+void Radix_Heap::destroy()
+{
+    for(vector<BHEntry>& bucket : buckets)
+    {
+        for(const BHEntry& entry : bucket)
+            where[entry.vertex] = -1;
+        bucket.clear();
+    }
+    count = 0;
+    last = 0;
+}
@@ -0,0 +1,276 @@
+#include "Rank_Pairing_Heap.h"
+#include "Search_Stats.h"
+#include <climits>
+
+/**
+ * @brief 构造秩配对堆
+ * 
+ * @param capacity 顶点编号上界，用于预分配句柄索引
+ */
+Rank_Pairing_Heap::Rank_Pairing_Heap(int capacity):min(nullptr), keyNum(0)
+{
+    handles.assign(capacity, nullptr);
+}
+
+Rank_Pairing_Heap::~Rank_Pairing_Heap()
+{
+}
+
+/**
+ * @brief 判断堆是否为空
+ * 
+ * @return 如果为空，则返回true；如果非空，则返回false
+ */
+bool Rank_Pairing_Heap::isEmpty()
+{
+    return min == nullptr;
+}
+
+/**
+ * @brief 获取堆中元素个数
+ * 
+ * @return 元素个数
+ */
+int Rank_Pairing_Heap::size()
+{
+    return keyNum;
+}
+
+/**
+ * @brief 获取最小键值对应的顶点
+ * 
+ * @param pkey 用于存储最小键值对应顶点的指针
+ * @return 堆非空返回true，否则返回false
+ */
+bool Rank_Pairing_Heap::minimum(int *pkey)
+{
+    if(min == nullptr || pkey == nullptr)
+        return false;
+    *pkey = min->vertex;
+    return true;
+}
+
+/**
+ * @brief 连接两棵同秩半树：键值大的根成为另一根的左孩子，原左子树挂到它的右边
+ * 
+ * @return 新的根，秩加1
+ */
+RPNode* Rank_Pairing_Heap::link(RPNode *a, RPNode *b)
+{
+    SEARCH_STAT(searchStats.link());
+    if(b->key < a->key)
+        swap(a, b);
+    b->right = a->left;
+    if(b->right != nullptr)
+        b->right->parent = b;
+    b->parent = a;
+    a->left = b;
+    a->rank = b->rank + 1;
+    return a;
+}
+
+/**
+ * @brief 按顶点查找节点，O(1)
+ */
+RPNode* Rank_Pairing_Heap::search(int vertex)
+{
+    if(vertex < 0 || vertex >= (int)handles.size())
+        return nullptr;
+    return handles[vertex];
+}
+
+void Rank_Pairing_Heap::setHandle(int vertex, RPNode *node)
+{
+    if(vertex >= (int)handles.size())
+        handles.resize(vertex + 1, nullptr);
+    handles[vertex] = node;
+}
+
+/**
+ * @brief 插入键值，新节点成为秩为0的根
+ * 
+ * @param key 键值
+ * @param vertex 顶点
+ */
+void Rank_Pairing_Heap::insert(int key, int vertex)
+{
+    if(search(vertex) != nullptr)
+        throw "alreay exists";
+    RPNode *node = pool.alloc(key, vertex);
+    setHandle(vertex, node);
+    roots.push_back(node);
+    if(min == nullptr || key < min->key)
+        min = node;
+    keyNum++;
+}
+
+/**
+ * @brief 降键：非根节点带着左子树成为新根，右子树补到原位置，再沿祖先降秩
+ * 
+ * @param node 节点
+ * @param key 新键值，不大于原键值
+ */
+void Rank_Pairing_Heap::decrease(RPNode *node, int key)
+{
+    node->key = key;
+    if(node->parent == nullptr)
+    {
+        if(key < min->key)
+            min = node;
+        return;
+    }
+    SEARCH_STAT(searchStats.cut());
+    RPNode *parent = node->parent;
+    RPNode *right = node->right;
+    if(parent->left == node)
+        parent->left = right;
+    else
+        parent->right = right;
+    if(right != nullptr)
+        right->parent = parent;
+    node->right = nullptr;
+    node->parent = nullptr;
+    node->rank = rankOf(node->left) + 1;
+    roots.push_back(node);
+    if(key < min->key)
+        min = node;
+    // 类型2规则：孩子秩差为(1,1)或(1,2)时秩为较大者+1，否则等于较大者
+    for(RPNode *u = parent; u != nullptr; u = u->parent)
+    {
+        int k;
+        if(u->parent == nullptr)
+            k = rankOf(u->left) + 1;
+        else
+        {
+            int a = rankOf(u->left), b = rankOf(u->right);
+            k = abs(a - b) <= 1 ? max(a, b) + 1 : max(a, b);
+        }
+        if(k >= u->rank)
+            break;
+        u->rank = k;
+        if(u->parent == nullptr)
+            break;
+    }
+}
+
+/**
+ * @brief 取出根node：左脊上的节点拆为新根，与其余根按秩一趟配对，再找出新的最小根
+ * 
+ * @param node 要取出的根
+ */
+void Rank_Pairing_Heap::extract(RPNode *node)
+{
+    for(RPNode *c = node->left; c != nullptr; )
+    {
+        RPNode *next = c->right;
+        c->right = nullptr;
+        c->parent = nullptr;
+        c->rank = rankOf(c->left) + 1;
+        roots.push_back(c);
+        c = next;
+    }
+    size_t count = 0;
+    for(RPNode *r : roots)
+    {
+        if(r == node)
+            continue;
+        if(r->rank >= (int)buckets.size())
+            buckets.resize(r->rank + 1, nullptr);
+        RPNode *&slot = buckets[r->rank];
+        if(slot == nullptr)
+            slot = r;
+        else
+        {
+            roots[count++] = link(slot, r); // 已配对的根不再参与本轮配对
+            slot = nullptr;
+        }
+    }
+    for(RPNode *&slot : buckets)
+    {
+        if(slot != nullptr)
+        {
+            roots[count++] = slot;
+            slot = nullptr;
+        }
+    }
+    roots.resize(count);
+    min = nullptr;
+    for(RPNode *r : roots)
+        if(min == nullptr || r->key < min->key)
+            min = r;
+}
+
+/**
+ * @brief 移除最小键值
+ */
+void Rank_Pairing_Heap::removeMin()
+{
+    if(min == nullptr)
+        return;
+    RPNode *old = min;
+    extract(old);
+    handles[old->vertex] = nullptr;
+    pool.release(old);
+    keyNum--;
+}
+
+/**
+ * @brief 判断顶点是否在堆中
+ * 
+ * @param vertex 顶点
+ * @return 在堆中返回true，否则返回false
+ */
+bool Rank_Pairing_Heap::contains(int vertex)
+{
+    return search(vertex) != nullptr;
+}
+
+/**
+ * @brief 修改顶点的键值，顶点不在堆中时插入
+ * 
+ * 增键时先降到最小值取出，再以新键值重新插入。
+ * 
+ * @param vertex 顶点
+ * @param newkey 新键值
+ */
+void Rank_Pairing_Heap::update(int vertex, int newkey)
+{
+    RPNode *node = search(vertex);
+    if(node == nullptr)
+    {
+        insert(newkey, vertex);
+        return;
+    }
+    if(newkey < node->key)
+        decrease(node, newkey);
+    else if(newkey > node->key)
+    {
+        decrease(node, INT_MIN);
+        min = node;
+        removeMin();
+        insert(newkey, vertex);
+    }
+}
+
+/**
+ * @brief 清空堆：沿半树重置仍在堆中的句柄，节点内存整体交还内存池
+ */
+void Rank_Pairing_Heap::destroy()
+{
+    buckets.clear();
+    buckets.insert(buckets.end(), roots.begin(), roots.end());
+    while(!buckets.empty())
+    {
+        RPNode *node = buckets.back();
+        buckets.pop_back();
+        handles[node->vertex] = nullptr;
+        if(node->left != nullptr)
+            buckets.push_back(node->left);
+        if(node->right != nullptr)
+            buckets.push_back(node->right);
+    }
+    roots.clear();
+    min = nullptr;
+    keyNum = 0;
+    pool.reset();
+}
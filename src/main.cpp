@@ -2,26 +2,43 @@
 #include "Fib_Heap.h"
 #include "Binomial_Queue.h"
 #include "Dijkstra.h"
+#include "CSR_Graph.h"
 #include "read_gr_txt.h"
+#include "Query_Generator.h"
+#include <filesystem>
 
 using namespace std;
 
-int main(){
+int main(int argc, char** argv){
     try{
-        Graph t({});
-        t.buildGraphFromtxt(".\\docs\\USA-road-d.NY.txt");
+        // 第二个参数可指定路网，默认docs/USA-road-d.NY.gr；快照与.gr同名，扩展名为.bin
+        filesystem::path grPath = argc > 2 ? filesystem::path(argv[2]) : filesystem::path("docs") / "USA-road-d.NY.gr";
+        filesystem::path binPath = filesystem::path(grPath).replace_extension(".bin");
+        CSRGraph t;
+        // 优先映射二进制快照，不存在或损坏时从.gr重建并写出快照
+        try{
+            t.loadSnapshot(binPath.string());
+        }catch(const char* msg){
+            cout << msg << ", rebuilding from .gr" << endl;
+            t.buildFromgr(grPath.string());
+            t.saveSnapshot(binPath.string());
+        }
+        // 参数给出querygen生成的查询集时使用它，否则按固定种子随机查询1000次
+        vector<Query> queries = argc > 1 ? QueryGenerator::load(argv[1]) : QueryGenerator(t, 1).random(1000);
+        Binomial_Queue bq(t.getV());
+        DijkstraWorkspace workspace;
         double sum = 0;
-        for(int i = 0; i < 100; i++)
+        for(const Query& q : queries)
         {
-            FibHeap fh;
-            Binomial_Queue bq;
-            LARGE_INTEGER t1,t2,tc;
-            QueryPerformanceFrequency(&tc);
-            QueryPerformanceCounter(&t1);
-            int d = dijkstra(t, 30, 27, bq);
-            cout <<"distance = "<< d;
-            QueryPerformanceCounter(&t2);
-            double time = (double)(t2.QuadPart-t1.QuadPart)/(double)tc.QuadPart; 
+            auto t1 = chrono::steady_clock::now();
+            try{
+                int d = dijkstra(t, q.src, q.dest, bq, workspace);
+                cout << q.src << " -> " << q.dest << " distance = " << d;
+            }catch(const char* msg){
+                cout << q.src << " -> " << q.dest << " " << msg;
+            }
+            auto t2 = chrono::steady_clock::now();
+            double time = chrono::duration<double>(t2 - t1).count();
             sum += time;
             cout<<" time = "<<time<<"s"<<endl;
         }
@@ -30,4 +47,4 @@ int main(){
         cout << msg << endl;
     }
     return 0;
-}
\ No newline at end of file
+}
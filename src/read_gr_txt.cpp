@@ -1,5 +1,15 @@
 #include "default.h"
 #include "read_gr_txt.h"
+#include <cstring>
+#include <cctype>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 using namespace std;
 
@@ -7,8 +17,8 @@ void gr2txt(){
     ifstream fin;
     ofstream fout;
     char temp[50];
-    fin.open(".\\docs\\USA-road-d.USA.gr");
-    fout.open(".\\docs\\USA-road-d.USA.txt");
+    fin.open("docs/USA-road-d.USA.gr");
+    fout.open("docs/USA-road-d.USA.txt");
     if(!fin.is_open())
         cout<<"Unable to open original .gr file, check your directory"<<endl;
     while(fin.getline(temp, 50))
@@ -20,3 +30,213 @@ void gr2txt(){
     fin.close();
     fout.close();
 }
+
+/**
+ * @brief 以只读方式映射整个文件
+ * 
+ * @param filePath 文件路径
+ * @param sequential 是否从头到尾顺序扫描：是则提示内核积极预读，否则(图快照上的
+ *                   随机访问)保持默认预读
+ */
+MappedFile::MappedFile(const string& filePath, bool sequential):data(nullptr), length(0)
+{
+#ifdef _WIN32
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL,
+                             OPEN_EXISTING, sequential ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_ATTRIBUTE_NORMAL, NULL);
+    mapHandle = NULL;
+    if(fileHandle == INVALID_HANDLE_VALUE)
+        throw "Unable to open file, check your directory";
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(fileHandle, &fileSize);
+    length = (size_t)fileSize.QuadPart;
+    if(length == 0)
+        return;
+    mapHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mapHandle == NULL)
+    {
+        CloseHandle(fileHandle);
+        throw "Unable to map file";
+    }
+    data = (const char*)MapViewOfFile(mapHandle, FILE_MAP_READ, 0, 0, 0);
+    if(data == NULL)
+    {
+        CloseHandle(mapHandle);
+        CloseHandle(fileHandle);
+        throw "Unable to map file";
+    }
+#else
+    fd = open(filePath.c_str(), O_RDONLY);
+    if(fd < 0)
+        throw "Unable to open file, check your directory";
+    struct stat st;
+    if(fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw "Unable to stat file";
+    }
+    length = (size_t)st.st_size;
+    if(length == 0)
+        return;
+    void* p = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(p == MAP_FAILED)
+    {
+        close(fd);
+        throw "Unable to map file";
+    }
+    madvise(p, length, sequential ? MADV_SEQUENTIAL : MADV_NORMAL);
+    data = (const char*)p;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if(data != NULL)
+        UnmapViewOfFile(data);
+    if(mapHandle != NULL)
+        CloseHandle(mapHandle);
+    CloseHandle(fileHandle);
+#else
+    if(data != nullptr)
+        munmap((void*)data, length);
+    close(fd);
+#endif
+}
+
+/**
+ * @brief 映射文件，从文件开头开始扫描
+ * 
+ * @param filePath 文件路径
+ */
+DimacsReader::DimacsReader(const string& filePath):file(filePath), cur(file.begin())
+{
+}
+
+/**
+ * @brief 跳到下一行行首
+ */
+void DimacsReader::skipLine()
+{
+    const char* nl = (const char*)memchr(cur, '\n', file.end() - cur);
+    cur = nl == nullptr ? file.end() : nl + 1;
+}
+
+/**
+ * @brief 找到"p"头部行，跳过其中的格式名("sp"或"aux sp co")，停在第一个数字之前
+ */
+void DimacsReader::skipProblemLine()
+{
+    if(!nextLine('p'))
+        throw "Missing problem line in DIMACS file";
+    while(cur < file.end() && (*cur == ' ' || *cur == '\t' || isalpha((unsigned char)*cur)))
+        cur++;
+}
+
+/**
+ * @brief 跳过空白后解析一个整数
+ * 
+ * 只有.co中的坐标可以为负；顶点数、顶点名和.gr中的权值遇到负号按格式错误处理。
+ * 
+ * @param allowNegative 是否接受负号
+ * @return 解析出的整数
+ */
+int DimacsReader::parseInt(bool allowNegative)
+{
+    while(cur < file.end() && (*cur == ' ' || *cur == '\t'))
+        cur++;
+    bool negative = allowNegative && cur < file.end() && *cur == '-';
+    if(negative)
+        cur++;
+    if(cur >= file.end() || *cur < '0' || *cur > '9')
+        throw "Malformed line in DIMACS file";
+    int value = 0;
+    while(cur < file.end() && *cur >= '0' && *cur <= '9')
+    {
+        value = value * 10 + (*cur - '0');
+        cur++;
+    }
+    return negative ? -value : value;
+}
+
+/**
+ * @brief 跳到下一个以tag开头的行，并越过tag，其余行(注释等)跳过
+ * 
+ * @param tag 行首字符
+ * @return 找到返回true，文件结束返回false
+ */
+bool DimacsReader::nextLine(char tag)
+{
+    while(cur < file.end())
+    {
+        if(*cur == tag)
+        {
+            cur++;
+            return true;
+        }
+        skipLine();
+    }
+    return false;
+}
+
+/**
+ * @brief 映射.gr文件并读取"p sp n m"头部
+ * 
+ * @param filePath .gr文件路径
+ */
+GrReader::GrReader(const string& filePath):DimacsReader(filePath), V(0), E(0)
+{
+    skipProblemLine();
+    V = parseInt();
+    E = parseInt();
+    skipLine();
+}
+
+/**
+ * @brief 读取下一条弧，跳过注释行
+ * 
+ * @param src 起点
+ * @param dest 终点
+ * @param weight 权值
+ * @return 读到弧返回true，文件结束返回false
+ */
+bool GrReader::next(int& src, int& dest, int& weight)
+{
+    if(!nextLine('a'))
+        return false;
+    src = parseInt();
+    dest = parseInt();
+    weight = parseInt();
+    skipLine();
+    return true;
+}
+
+/**
+ * @brief 映射.co文件并读取"p aux sp co n"头部
+ * 
+ * @param filePath .co文件路径
+ */
+CoReader::CoReader(const string& filePath):DimacsReader(filePath), V(0)
+{
+    skipProblemLine();
+    V = parseInt();
+    skipLine();
+}
+
+/**
+ * @brief 读取下一个顶点坐标，跳过注释行
+ * 
+ * @param id 顶点名
+ * @param x 经度*10^6
+ * @param y 纬度*10^6
+ * @return 读到坐标返回true，文件结束返回false
+ */
+bool CoReader::next(int& id, int& x, int& y)
+{
+    if(!nextLine('v'))
+        return false;
+    id = parseInt();
+    x = parseInt(true);
+    y = parseInt(true);
+    skipLine();
+    return true;
+}
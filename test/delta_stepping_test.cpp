@@ -0,0 +1,95 @@
+#include "default.h"
+#include "Dijkstra.h"
+#include "CSR_Graph.h"
+#include "Delta_Stepping.h"
+
+using namespace std;
+
+static int failures = 0;
+
+/**
+ * @brief 随机有向图，不保证连通，顺带检查不可达顶点的MAX
+ */
+static Graph randomGraph(mt19937& rng, int n, int m, int maxWeight)
+{
+    Graph graph;
+    for(int i = 0; i < m; i++)
+    {
+        int u = 1 + rng() % n, v = 1 + rng() % n;
+        if(u != v)
+            graph.addEdge(u, v, 1 + rng() % maxWeight);
+    }
+    return graph;
+}
+
+int main()
+{
+    mt19937 rng(5);
+    int runs = 0;
+    // 边权范围从远小于delta到远大于delta，覆盖只有轻边、只有重边和混合的情况
+    for(int trial = 0; trial < 30; trial++)
+    {
+        int n = 50 + rng() % 400;
+        int maxWeight = trial % 3 == 0 ? 5 : trial % 3 == 1 ? 1000 : 100000;
+        Graph graph = randomGraph(rng, n, n * (1 + rng() % 5), maxWeight);
+        CSRGraph csr;
+        csr.buildFromGraph(graph);
+        Binary_Heap queue(4, csr.getBound());
+        DijkstraWorkspace space;
+        for(int delta : {0, 1, 7, maxWeight / 3 + 1, maxWeight * 2})
+            for(int threads : {1, 2, 3, 8})
+            {
+                DeltaStepping stepping(csr, delta, threads);
+                for(int k = 0; k < 3; k++)
+                {
+                    int src = csr.name(rng() % csr.getV());
+                    vector<int> expected = dijkstraAll(csr, src, queue, space);
+                    vector<int> actual = stepping.run(src);
+                    runs++;
+                    if(actual != expected)
+                    {
+                        cout << "FAILED: trial " << trial << " delta " << stepping.getDelta() << " threads " << threads
+                             << " src " << src << endl;
+                        failures++;
+                    }
+                }
+            }
+    }
+
+    // 同一对象改变delta后重复查询
+    Graph graph = randomGraph(rng, 200, 800, 50);
+    CSRGraph csr;
+    csr.buildFromGraph(graph);
+    Binary_Heap queue(4, csr.getBound());
+    DijkstraWorkspace space;
+    DeltaStepping stepping(csr, 3, 4);
+    for(int delta : {3, 40, 1, 0})
+    {
+        stepping.setDelta(delta);
+        int src = csr.name(rng() % csr.getV());
+        if(stepping.run(src) != dijkstraAll(csr, src, queue, space))
+        {
+            cout << "FAILED: setDelta " << delta << " src " << src << endl;
+            failures++;
+        }
+    }
+
+    bool rejected = false;
+    try
+    {
+        stepping.run(-7);
+    }
+    catch(const char*)
+    {
+        rejected = true;
+    }
+    if(!rejected)
+    {
+        cout << "FAILED: unknown source accepted" << endl;
+        failures++;
+    }
+
+    if(failures == 0)
+        cout << "delta_stepping_test: ok (" << runs << " runs)" << endl;
+    return failures == 0 ? 0 : 1;
+}
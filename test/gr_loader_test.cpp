@@ -0,0 +1,99 @@
+#include "default.h"
+#include "Dijkstra.h"
+#include "CSR_Graph.h"
+#include <filesystem>
+#include <algorithm>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string& what)
+{
+    if(!ok)
+    {
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+static string writeFile(const string& name, const string& content)
+{
+    string path = (filesystem::temp_directory_path() / name).string();
+    ofstream out(path);
+    out << content;
+    return path;
+}
+
+/**
+ * @brief 取u的全部出边，按(终点名, 权值)排序后比较
+ */
+static vector<pair<int, int>> arcsOf(const CSRGraph& g, int name)
+{
+    vector<pair<int, int>> out;
+    for(const Edge& e : g.edges(g.index(name)))
+        out.push_back(make_pair(g.name(e.dest), e.weight));
+    sort(out.begin(), out.end());
+    return out;
+}
+
+int main()
+{
+    // 弧未按起点排序：起点2的弧在起点1之前，必须走计数排序
+    string unsorted = writeFile("gr_loader_unsorted.gr", "c unsorted\np sp 3 3\na 2 3 5\na 1 2 7\na 3 1 4\n");
+    CSRGraph g;
+    g.buildFromgr(unsorted);
+    check(arcsOf(g, 1) == vector<pair<int, int>>{{2, 7}}, "unsorted: arcs of 1");
+    check(arcsOf(g, 2) == vector<pair<int, int>>{{3, 5}}, "unsorted: arcs of 2");
+    check(arcsOf(g, 3) == vector<pair<int, int>>{{1, 4}}, "unsorted: arcs of 3");
+
+    // 与Graph从同一文件建图的结果一致
+    string shuffled = writeFile("gr_loader_shuffled.gr",
+        "p sp 5 7\na 4 5 1\na 1 2 3\na 3 4 2\na 1 3 9\na 2 3 1\na 5 1 6\na 2 5 8\n");
+    CSRGraph csr;
+    csr.buildFromgr(shuffled);
+    Graph graph;
+    graph.buildGraphFromgr(shuffled);
+    for(int v = 1; v <= 5; v++)
+    {
+        vector<pair<int, int>> expected;
+        for(const Edge& e : graph.edges(v))
+            expected.push_back(make_pair(e.dest, e.weight));
+        sort(expected.begin(), expected.end());
+        check(arcsOf(csr, v) == expected, "shuffled: arcs of " + to_string(v));
+    }
+    Binary_Heap queue(4, csr.getBound());
+    check(dijkstra(csr, 1, 5, queue) == 7, "shuffled: distance 1->5");
+
+    // .gr中的负权值按格式错误拒绝，两种图都不能建出来
+    string negative = writeFile("gr_loader_negative.gr", "p sp 2 1\na 1 2 -5\n");
+    bool rejected = false;
+    try
+    {
+        CSRGraph bad;
+        bad.buildFromgr(negative);
+    }
+    catch(const char*)
+    {
+        rejected = true;
+    }
+    check(rejected, "negative: CSRGraph rejects negative weight");
+    rejected = false;
+    try
+    {
+        Graph bad;
+        bad.buildGraphFromgr(negative);
+    }
+    catch(const char*)
+    {
+        rejected = true;
+    }
+    check(rejected, "negative: Graph rejects negative weight");
+
+    filesystem::remove(unsorted);
+    filesystem::remove(shuffled);
+    filesystem::remove(negative);
+    if(failures == 0)
+        cout << "gr_loader_test: ok" << endl;
+    return failures == 0 ? 0 : 1;
+}
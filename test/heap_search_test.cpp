@@ -0,0 +1,129 @@
+#include "default.h"
+#include "Dijkstra.h"
+#include "Bidirectional_Dijkstra.h"
+#include "ALT.h"
+#include "CSR_Graph.h"
+
+using namespace std;
+
+static int failures = 0;
+
+/**
+ * @brief 强连通的随机图：一条经过全部顶点的环加随机边，使ALT的势函数一致，单调队列也适用
+ */
+static Graph randomGraph(mt19937& rng, int n, int maxWeight)
+{
+    Graph graph;
+    for(int v = 1; v < n; v++)
+        graph.addEdge(v, v + 1, 1 + rng() % maxWeight);
+    graph.addEdge(n, 1, 1 + rng() % maxWeight);
+    for(int i = 0; i < n * 3; i++)
+    {
+        int u = 1 + rng() % n, v = 1 + rng() % n;
+        if(u != v)
+            graph.addEdge(u, v, 1 + rng() % maxWeight);
+    }
+    return graph;
+}
+
+/**
+ * @brief 用同一种堆跑dijkstra、双向Dijkstra和A*，与参考距离比较
+ */
+template<class Queue, class GraphT>
+static void checkHeap(const string& name, const GraphT& graph, const GraphT& reverse, const Landmarks& landmarks,
+                      const vector<pair<int, int>>& queries, const vector<int>& expected, Queue& forward, Queue& backward)
+{
+    DijkstraWorkspace space, other;
+    for(size_t i = 0; i < queries.size(); i++)
+    {
+        int s = queries[i].first, t = queries[i].second;
+        int plain = -1, bidirectional = -1, alt = -1;
+        try{
+            plain = dijkstra(graph, s, t, forward, space);
+            bidirectional = bidirectionalDijkstra(graph, reverse, s, t, forward, backward, space, other);
+            alt = astar(graph, landmarks, s, t, forward, space);
+        }catch(const char* msg){
+            cout << name << ": " << msg << endl;
+        }
+        if(plain != expected[i] || bidirectional != expected[i] || alt != expected[i])
+        {
+            cout << "FAILED: " << name << " " << s << "->" << t << " expected " << expected[i] << " dijkstra " << plain
+                 << " bidirectional " << bidirectional << " astar " << alt << endl;
+            failures++;
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 对每种堆调用checkHeap，dialWindow为Dial_Queue的桶窗口
+ */
+template<class GraphT>
+static void checkAllHeaps(const string& prefix, const GraphT& graph, const GraphT& reverse, const Landmarks& landmarks,
+                          const vector<pair<int, int>>& queries, const vector<int>& expected, int dialWindow)
+{
+    int bound = graph.getBound();
+    {FibHeap a(bound), b(bound); checkHeap(prefix + "fib", graph, reverse, landmarks, queries, expected, a, b);}
+    {Index_Fib_Heap a(bound), b(bound); checkHeap(prefix + "index_fib", graph, reverse, landmarks, queries, expected, a, b);}
+    {Binomial_Queue a(bound), b(bound); checkHeap(prefix + "binomial", graph, reverse, landmarks, queries, expected, a, b);}
+    {Binary_Heap a(4, bound), b(4, bound); checkHeap(prefix + "4-ary", graph, reverse, landmarks, queries, expected, a, b);}
+    {Pairing_Heap a(bound), b(bound); checkHeap(prefix + "pairing", graph, reverse, landmarks, queries, expected, a, b);}
+    {Rank_Pairing_Heap a(bound), b(bound); checkHeap(prefix + "rank_pairing", graph, reverse, landmarks, queries, expected, a, b);}
+    {Radix_Heap a(bound), b(bound); checkHeap(prefix + "radix", graph, reverse, landmarks, queries, expected, a, b);}
+    // A*的约化边权最大可到maxWeight加势函数的跨度，桶窗口按最长路径放宽
+    {Dial_Queue a(dialWindow, bound), b(dialWindow, bound); checkHeap(prefix + "dial", graph, reverse, landmarks, queries, expected, a, b);}
+    {Lazy_Queue a(bound), b(bound); checkHeap(prefix + "lazy", graph, reverse, landmarks, queries, expected, a, b);}
+}
+
+int main()
+{
+    mt19937 rng(11);
+    const int maxWeight = 100;
+    for(int trial = 0; trial < 10; trial++)
+    {
+        int n = 50 + rng() % 300;
+        Graph graph = randomGraph(rng, n, maxWeight);
+        Graph reverse = graph.reverse();
+        Landmarks landmarks;
+        landmarks.build(graph, 4);
+        int bound = graph.getBound();
+
+        vector<pair<int, int>> queries;
+        vector<int> expected;
+        Binary_Heap reference(2, bound);
+        for(int k = 0; k < 40; k++)
+        {
+            int s = 1 + rng() % n, t = 1 + rng() % n;
+            queries.push_back(make_pair(s, t));
+            expected.push_back(dijkstra(graph, s, t, reference));
+        }
+
+        checkAllHeaps("", graph, reverse, landmarks, queries, expected, maxWeight * n);
+
+        // CSRGraph用压缩编号，地标须在CSRGraph上重新预处理；按顶点名建的表必须被拒绝
+        CSRGraph csr, csrReverse;
+        csr.buildFromGraph(graph);
+        csrReverse.buildFromGraph(reverse);
+        Landmarks csrLandmarks;
+        csrLandmarks.build(csr, 4);
+        checkAllHeaps("csr ", csr, csrReverse, csrLandmarks, queries, expected, maxWeight * n);
+        bool rejected = false;
+        try
+        {
+            Binary_Heap queue(4, csr.getBound());
+            astar(csr, landmarks, queries[0].first, queries[0].second, queue);
+        }
+        catch(const char*)
+        {
+            rejected = true;
+        }
+        if(!rejected)
+        {
+            cout << "FAILED: Graph landmarks accepted for a CSRGraph" << endl;
+            failures++;
+        }
+    }
+    if(failures == 0)
+        cout << "heap_search_test: ok" << endl;
+    return failures == 0 ? 0 : 1;
+}
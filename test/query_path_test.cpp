@@ -0,0 +1,66 @@
+#include "default.h"
+#include "Dijkstra.h"
+#include "CSR_Graph.h"
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string& what)
+{
+    if(!ok)
+    {
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+/**
+ * @brief predecessor对该顶点是否抛出"Vertex not reached"
+ */
+static bool unreached(const QueryResult& result, int name)
+{
+    try{
+        result.predecessor(name);
+    }catch(const char*){
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief 1->2->3->4的路径，5只有出边，查询1到4时不会被到达
+ */
+template<class GraphT>
+static void checkPath(const string& label, const GraphT& graph)
+{
+    Binary_Heap queue(4, graph.getBound());
+    DijkstraWorkspace workspace;
+    QueryResult result = dijkstraPath(graph, 1, 4, queue, workspace);
+    check(result.distance == 6, label + ": distance");
+    check(result.path() == vector<int>{1, 2, 3, 4}, label + ": path");
+    check(result.predecessor(4) == 3, label + ": predecessor of 4");
+    check(result.predecessor(1) == -1, label + ": predecessor of source");
+    check(unreached(result, 5), label + ": unreached vertex");
+    // 超出顶点编号上界的名字不能读到工作区之外
+    check(unreached(result, 6), label + ": name just past the bound");
+    check(unreached(result, 1000000), label + ": name far past the bound");
+    check(unreached(result, -1), label + ": negative name");
+}
+
+int main()
+{
+    Graph graph;
+    graph.addEdge(1, 2, 1);
+    graph.addEdge(2, 3, 2);
+    graph.addEdge(3, 4, 3);
+    graph.addEdge(1, 4, 10);
+    graph.addEdge(5, 1, 1);
+    CSRGraph csr;
+    csr.buildFromGraph(graph);
+    checkPath("graph", graph);
+    checkPath("csr", csr);
+    if(failures == 0)
+        cout << "query_path_test: ok" << endl;
+    return failures == 0 ? 0 : 1;
+}
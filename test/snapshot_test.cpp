@@ -0,0 +1,94 @@
+#include "default.h"
+#include "Dijkstra.h"
+#include "CSR_Graph.h"
+#include <filesystem>
+#include <cstring>
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string& what)
+{
+    if(!ok)
+    {
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+/**
+ * @brief 把快照复制一份，在给定字节偏移处写入一个int，模拟大小正确的损坏文件
+ */
+static string corrupt(const string& source, const string& name, size_t offset, int value)
+{
+    string path = (filesystem::temp_directory_path() / name).string();
+    filesystem::copy_file(source, path, filesystem::copy_options::overwrite_existing);
+    fstream file(path, ios::in | ios::out | ios::binary);
+    file.seekp(offset);
+    file.write((const char*)&value, sizeof(value));
+    return path;
+}
+
+static bool rejects(const string& path, bool verify)
+{
+    try{
+        CSRGraph g;
+        g.loadSnapshot(path, verify);
+    }catch(const char*){
+        return true;
+    }
+    return false;
+}
+
+int main()
+{
+    Graph graph;
+    graph.addEdge(1, 2, 3);
+    graph.addEdge(2, 3, 4);
+    graph.addEdge(3, 1, 5);
+    graph.addEdge(1, 3, 9);
+    CSRGraph csr;
+    csr.buildFromGraph(graph);
+    string path = (filesystem::temp_directory_path() / "snapshot_test.bin").string();
+    csr.saveSnapshot(path);
+
+    CSRGraph loaded;
+    loaded.loadSnapshot(path, false);
+    Binary_Heap queue(4, loaded.getBound());
+    check(dijkstra(loaded, 1, 3, queue) == 7, "round trip distance");
+
+    // 布局：64字节头部 | offsets[V+1] | arcs[E] | names[V] | ids[idCount]
+    const size_t header = 64;
+    int V = csr.getV(), E = csr.getE();
+    size_t offsets = header, arcs = offsets + sizeof(int) * (V + 1);
+    size_t ids = arcs + sizeof(Edge) * E + sizeof(int) * V;
+    struct Case{
+        string name;
+        size_t offset;
+        int value;
+    };
+    vector<Case> cases = {
+        {"interior offset beyond E", offsets + sizeof(int), E + 100},
+        {"decreasing offsets", offsets + sizeof(int) * 2, 0},
+        {"arc dest out of range", arcs, V + 7},
+        {"negative arc dest", arcs + sizeof(Edge), -3},
+        {"id out of range", ids + sizeof(int), V + 1},
+    };
+    // 数据段只在verify时检查，verify=false是信任文件的快速路径
+    for(const Case& c : cases)
+    {
+        string bad = corrupt(path, "snapshot_test_bad.bin", c.offset, c.value);
+        check(rejects(bad, true), c.name);
+        filesystem::remove(bad);
+    }
+    // 头部总是校验：改动V使头部校验和不符
+    string bad = corrupt(path, "snapshot_test_bad.bin", 16, V + 1);
+    check(rejects(bad, false), "header V changed (verify=false)");
+    check(rejects(bad, true), "header V changed (verify=true)");
+    filesystem::remove(bad);
+    filesystem::remove(path);
+    if(failures == 0)
+        cout << "snapshot_test: ok" << endl;
+    return failures == 0 ? 0 : 1;
+}